@@ -37,6 +37,7 @@
 #include "dyntypes.h"
 #include <vector>
 #include <map>
+#include <atomic>
 #include <typeinfo>
 #include <string>
 #include <string.h> // for strrchr()
@@ -475,8 +476,10 @@ class COMMON_EXPORT AnnotatableDense
 	  }
 };
 
-#define NON_STATIC_SPARSE_MAP 1
-#define AN_INLINE inline
+#if defined (_MSC_VER)
+#pragma warning (push)
+#pragma warning (disable:4251)
+#endif
 
 class COMMON_EXPORT AnnotatableSparse
 {
@@ -486,139 +489,90 @@ class COMMON_EXPORT AnnotatableSparse
 			AnnotatableSparse *, std::vector<ser_rec_t> &);
 
    public:
-      struct void_ptr_hasher
+      struct anno_rec_t
       {
-         size_t operator()(const void* a) const
-         {
-            return (size_t) a;
-         }
+         AnnotationClassID id;
+         void *data;
       };
 
-#if defined (_MSC_VER)
-      typedef dyn_hash_map<void *, void *> annos_by_type_t;
-#pragma warning (push)
-#pragma warning (disable:4251)
-#else
-      typedef dyn_hash_map<void *, void *, void_ptr_hasher> annos_by_type_t;
-#endif
+      /**
+       * Each object points at a small array of (id, annotation) pairs, kept
+       * sorted by id.  The array is never changed once it is published:
+       * writers build a new one and swap the pointer, so readers need no
+       * lock.  Without concurrent writes the old array is freed at once;
+       * with them it is chained onto the new one and freed with the object,
+       * since a reader on another thread may still be scanning it.
+       **/
+      struct anno_list_t
+      {
+         anno_list_t *retired;
+         unsigned short size;
+         anno_rec_t recs[1];
+      };
 
-      typedef std::vector<annos_by_type_t *> annos_t;
+      //  Turn on before annotating objects from more than one thread at once
+      static void setConcurrentAnnotationWrites(bool on);
+      static bool concurrentAnnotationWrites();
+
+      AnnotatableSparse() : annos_(NULL)
+      {
+      }
+
+      //  Annotations belong to an object, not its value: a copy starts
+      //  without any, and assignment leaves the target's alone.
+      AnnotatableSparse(const AnnotatableSparse &) : annos_(NULL)
+      {
+      }
+
+      AnnotatableSparse &operator=(const AnnotatableSparse &)
+      {
+         return *this;
+      }
 
 	  ~AnnotatableSparse()
 	  {
-		  //  We need to remove annotations from the static map when objects
-		  //  are destroyed:  (1)  memory may be reclaimed and reused at the same
-		  //  place, and (2) regardless of 1, the map can possibly explode to 
-		  //  unmanageable sizes, with a lot of unused junk in it if a lot of i
-		  //  annotatable objects are created and destroyed.
-
-		  //  Alas this is kinda expensive right now, but the data structure is
-		  //  set up to minimize search time, not deletion time.  It could
-		  //  be changed if this becomes a significant time drain.
-
-		  unsigned int n = 0;
-		  for (unsigned int i = 0; i < getAnnos()->size(); ++i)
+		  anno_list_t *l = annos_.load(std::memory_order_relaxed);
+		  if (l && annotation_debug_flag())
 		  {
-			  annos_by_type_t *abt = (*getAnnos())[i];
-			  if (!abt) continue;
-
-			  annos_by_type_t::iterator iter = abt->find(this);
-			  if (iter != abt->end())
+			  for (unsigned int i = 0; i < l->size; ++i)
 			  {
-				  if (annotation_debug_flag())
-				  {
-					  fprintf(stderr, "%s[%d]:  Sparse(%p) dtor remove %s-%d\n", FILE__, __LINE__,  
-							  this, AnnotationClassBase::findAnnotationClass(i) 
-							  ? AnnotationClassBase::findAnnotationClass(i)->getName().c_str() 
-							  : "bad_anno_id", i);
-				  }
-
-				  abt->erase(iter);
-				  n++;
-
-				  //  get rid of this check...  just making sure that erase is behaving as
-				  //  expected...
-				  annos_by_type_t::iterator iter2 = abt->find(this);
-				  if (iter2 != abt->end())
-					  fprintf(stderr, "%s[%d]:  FIXME:  REMOVE FAILED\n", FILE__, __LINE__);
+				  fprintf(stderr, "%s[%d]:  Sparse(%p) dtor remove %s-%d\n", FILE__, __LINE__,  
+						  this, AnnotationClassBase::findAnnotationClass(l->recs[i].id) 
+						  ? AnnotationClassBase::findAnnotationClass(l->recs[i].id)->getName().c_str() 
+						  : "bad_anno_id", l->recs[i].id);
 			  }
 		  }
+		  while (l)
+		  {
+			  anno_list_t *next = l->retired;
+			  free(l);
+			  l = next;
+		  }
 	  }
 
    private:
 
-#if defined (NON_STATIC_SPARSE_MAP)
-      //COMMON_EXPORT static annos_t *annos;
-#else
-      static annos_t annos;
-#endif
-	  annos_t *getAnnos() const;
+      std::atomic<anno_list_t *> annos_;
 	  static dyn_hash_map<void *, unsigned short> ser_ndx_map;
 
-      annos_by_type_t *getAnnosOfType(AnnotationClassID aid, bool do_create =false) const
-	  {
-		  annos_t &l_annos = *getAnnos();
-         long nelems_to_create = aid - l_annos.size() + 1;
-
-         if (nelems_to_create > 0)
-         {
-            if (!do_create)
-            {
-               return NULL;
-            }
-
-            while (nelems_to_create)
-            {
-               annos_by_type_t *newl = new annos_by_type_t();
-               l_annos.push_back(newl);
-               nelems_to_create--;
-            }
-         }
-
-         annos_by_type_t *abt = l_annos[aid];
-
-         return abt;
-      }
-
-      template <class T>
-      AN_INLINE annos_by_type_t *getAnnosOfType(AnnotationClass<T> &a_id, bool do_create =false) const
+      static void *findAnno(const anno_list_t *l, AnnotationClassID aid)
       {
-         AnnotationClassID aid = a_id.getID();
-
-		 return getAnnosOfType(aid, do_create);
-	  }
-
-
-      void *getAnnosForObject(annos_by_type_t *abt,
-            void *obj, bool do_create = false) const 
-      {
-         assert(abt);
-         assert(obj);
-
-         void  *target = NULL;
-
-         annos_by_type_t::iterator iter = abt->find(obj);
-
-         if (iter == abt->end())
+         if (!l) return NULL;
+         for (unsigned int i = 0; i < l->size; ++i)
          {
-            if (!do_create)
-            {
-               return NULL;
-            }
-
-            (*abt)[obj] = target;
+            if (l->recs[i].id == aid) return l->recs[i].data;
+            if (l->recs[i].id > aid) break;
          }
-         else
-         {
-            target = iter->second;
-         }
-
-         return target;
+         return NULL;
       }
 
+      //  Publish a copy of the current list with aid set to a (or dropped if
+      //  a is NULL).  Returns the annotation it replaced, if any.
+      bool setAnno(AnnotationClassID aid, void *a, void *&prev);
+
 	  //  private version of addAnnotation used by deserialize function to restore
 	  //  annotation set without explicitly specifying types
-	  AN_INLINE bool addAnnotation(const void *a, AnnotationClassID aid)
+	  bool addAnnotation(const void *a, AnnotationClassID aid)
 	  {
 		  if (annotation_debug_flag())
 		  {
@@ -628,35 +582,10 @@ class COMMON_EXPORT AnnotatableSparse
 					  : "bad_anno_id", aid);
 		  }
 
-		  void *obj = this;
-		  annos_by_type_t *abt = getAnnosOfType(aid, true /*do create if needed*/);
-		  assert(abt);
-
-		  annos_by_type_t::iterator iter = abt->find(obj);
-		  if (iter == abt->end())
-		  {
-			  (*abt)[obj] = const_cast<void *>(a);
-		  }
-		  else
-		  {
-			  //  do silent replacement -- this case can arise if an annotatable object
-			  //  is destroyed and then reallocated as a new object at the same address.
-			  //  Given the sparse map data structure, it would be rather expensive to 
-			  //  go through the map in the dtor to eliminate references to the 
-			  //  destroyed object.
-
-			  //  Added annotation removal in dtor...  so this case should _not_ arise,
-			  //  do the replacement, but make some noise:
-
-			  if (a != iter->second)
-			  {
-				  annotatable_printf("%s[%d]:  WEIRD:  already have annotation of this type: %p, replacing with %p\n", FILE__, __LINE__, iter->second, a);
-				  iter->second = const_cast<void *>(a);
-			  }
-
-			  return true;
-		  }
-
+		  void *prev = NULL;
+		  setAnno(aid, const_cast<void *>(a), prev);
+		  if (prev && prev != a)
+			  annotatable_printf("%s[%d]:  WEIRD:  already have annotation of this type: %p, replacing with %p\n", FILE__, __LINE__, prev, a);
 		  return true;
 	  }
 
@@ -664,120 +593,53 @@ class COMMON_EXPORT AnnotatableSparse
 
 	  bool operator==(AnnotatableSparse &cmp)
 	  {
-		  annos_t &l_annos = *getAnnos();
-		  unsigned this_ntypes = l_annos.size();
-         unsigned cmp_ntypes = cmp.getAnnos()->size();
-         unsigned ntypes = (cmp_ntypes > this_ntypes) ? cmp_ntypes : this_ntypes;
-
-         for (unsigned int i = 0; i < ntypes; ++i) 
-         {
-            if ((i >= cmp_ntypes) || (i >= this_ntypes)) 
-            {
-               //  compare is done since at least one set of annotations
-               //  has been exhausted
-               break;
-            }
-
-            annos_by_type_t *this_abt = l_annos[i];
-            annos_by_type_t *cmp_abt = (*cmp.getAnnos())[i];
-
-            if (!this_abt) 
-            {
-               fprintf(stderr, "%s[%d]:  WEIRD: FIXME\n", FILE__, __LINE__);
-               continue;
-            }
-
-            if (!cmp_abt) 
-            {
-               fprintf(stderr, "%s[%d]:  WEIRD: FIXME\n", FILE__, __LINE__);
-               continue;
-            }
-
-            annos_by_type_t::iterator this_abt_iter = this_abt->find(this);
-            annos_by_type_t::iterator cmp_abt_iter = cmp_abt->find(&cmp);
-
-            //  if one has annotations of this particular type and other other
-            //  doesn't, then we are def. not equal, so fail:
-
-            if (this_abt_iter == this_abt->end())
-            {
-               if (cmp_abt_iter != cmp_abt->end())
-               {
-                  return false;
-               }
-
-               //  both are at end()
-               continue;
-            }
-
-            if (   (cmp_abt_iter == cmp_abt->end())
-                  && (this_abt_iter != this_abt->end()))
-            {
-               return false;
-            }
-
-            AnnotationClassBase *acb = AnnotationClassBase::findAnnotationClass(i);
-
-            if (!acb)
-            {
-               return false;
-            }
-
-            //  both have annotation -- do the compare
-            anno_cmp_func_t cmpfunc = acb->getCmpFunc();
-
-            if (!cmpfunc)
-            {
-               //  even if not explicitly specified, a default pointer-compare
-               //  function should be returned here.
-
-               fprintf(stderr, "%s[%d]:  no cmp func for anno id %d\n", 
-                     FILE__, __LINE__, i);
-               return false;
-            }
+		  const anno_list_t *this_l = annos_.load(std::memory_order_acquire);
+		  const anno_list_t *cmp_l = cmp.annos_.load(std::memory_order_acquire);
+		  unsigned this_n = this_l ? this_l->size : 0;
+		  unsigned cmp_n = cmp_l ? cmp_l->size : 0;
+
+		  //  Both lists are sorted by id; the lowest id present in either
+		  //  decides the comparison.
+		  if (!this_n && !cmp_n)
+			  return true;
+		  if (!this_n || !cmp_n)
+			  return false;
+		  if (this_l->recs[0].id != cmp_l->recs[0].id)
+			  return false;
 
-            void *arg1 = cmp_abt_iter->second;
-            void *arg2 = this_abt_iter->second;
+		  AnnotationClassID id = this_l->recs[0].id;
+		  AnnotationClassBase *acb = AnnotationClassBase::findAnnotationClass(id);
+		  if (!acb)
+		  {
+			  return false;
+		  }
 
-            bool ret = (*cmpfunc)(arg1, arg2);
+		  anno_cmp_func_t cmpfunc = acb->getCmpFunc();
+		  if (!cmpfunc)
+		  {
+			  //  even if not explicitly specified, a default pointer-compare
+			  //  function should be returned here.
 
-            return ret;
-         }
+			  fprintf(stderr, "%s[%d]:  no cmp func for anno id %d\n", 
+					  FILE__, __LINE__, id);
+			  return false;
+		  }
 
-         return true;
+		  return (*cmpfunc)(cmp_l->recs[0].data, this_l->recs[0].data);
       }
 
       template<class T>
-      AN_INLINE bool addAnnotation(const T *a, AnnotationClass<T> &a_id)
+      bool addAnnotation(const T *a, AnnotationClass<T> &a_id)
          {
 		  annotatable_printf("%s[%d]:  Sparse(%p):  Add %s-%d, %s\n", FILE__, __LINE__, 
 				  this, a_id.getName().c_str(), a_id.getID(), typeid(T).name());
-            void *obj = this;
-            annos_by_type_t *abt = getAnnosOfType(a_id, true /*do create if needed*/);
-            assert(abt);
 
-            annos_by_type_t::iterator iter = abt->find(obj);
-            if (iter == abt->end())
+            void *prev = NULL;
+            setAnno(a_id.getID(), (void *) const_cast<T *>(a), prev);
+            if (prev)
             {
-               (*abt)[obj] = (void *) const_cast<T *>(a);
-            }
-            else
-            {
-				//  do silent replacement -- this case can arise if an annotatable object
-				//  is destroyed and then reallocated as a new object at the same address.
-				//  Given the sparse map data structure, it would be rather expensive to 
-				//  go through the map in the dtor to eliminate references to the 
-				//  destroyed object.
-
-				//  Added annotation removal in dtor...  so this case should _not_ arise,
-				//  do the replacement, but make some noise:
-
-				if (iter->second != a) 
-				{
-					//fprintf(stderr, "%s[%d]:  WEIRD:  already have annotation of type %s: %p, replacing with %p\n", FILE__, __LINE__, a_id.getName().c_str(), iter->second, a);
-					iter->second = (void *)const_cast<T *>(a);
-				}
-
+				//  do silent replacement; there is no serialization to
+				//  replay for an annotation we already had
 				return true;
             }
 
@@ -812,28 +674,10 @@ class COMMON_EXPORT AnnotatableSparse
          }
 
       template<class T>
-      AN_INLINE bool getAnnotation(T *&a, AnnotationClass<T> &a_id) const 
+      inline bool getAnnotation(T *&a, AnnotationClass<T> &a_id) const 
       {
-         a = NULL;
-
-         annos_by_type_t *abt = getAnnosOfType(a_id, false /*don't create if none*/);
-
-         if (!abt)
-         {
-            return false;
-         }
-
-         AnnotatableSparse * this_noconst = const_cast<AnnotatableSparse *>(this);
-         void *annos_for_object = getAnnosForObject(abt, (void *)this_noconst,
-               false /*no create if none*/);
-
-         if (!annos_for_object)
-         {
-            return false;
-         }
-
-         a = (T *)annos_for_object;
-         return true;
+         a = (T *) findAnno(annos_.load(std::memory_order_acquire), a_id.getID());
+         return (a != NULL);
       }
 
 	  template<class T>
@@ -845,43 +689,21 @@ class COMMON_EXPORT AnnotatableSparse
 					  this, a_id.getName().c_str(), a_id.getID(), typeid(T).name());
 		  }
 
-		  void *obj = this;
-		  annos_by_type_t *abt = getAnnosOfType(a_id, false /*do create if needed*/);
-		  assert(abt);
-
-		  annos_by_type_t::iterator iter = abt->find(obj);
-		  if (iter == abt->end())
-		  {
-			  //  annotation does not exist, so we return false (remove failed)
-			  return false;
-		  }
-		  else
-		  {
-			  abt->erase(iter);
-			  return true;
-		  }
-	      return false;
+		  void *prev = NULL;
+		  setAnno(a_id.getID(), NULL, prev);
+		  //  if the annotation did not exist, we return false (remove failed)
+		  return (prev != NULL);
 	  }
 
     void serializeAnnotations(SerializerBase *sb, const char *)
 	  {
-		  annos_t &l_annos = *getAnnos();
 		  std::vector<ser_rec_t> my_sers;
-            void *obj = this;
 			if (is_output(sb))
 			{
-				for (AnnotationClassID id = 0; id < l_annos.size(); ++id)
+				const anno_list_t *l = annos_.load(std::memory_order_acquire);
+				for (unsigned int i = 0; l && i < l->size; ++i)
 				{
-					annos_by_type_t *abt = getAnnosOfType(id, false /*don't do create */);
-					if (NULL == abt) continue;
-
-					annos_by_type_t::iterator iter = abt->find(obj);
-
-					if (iter == abt->end()) 
-					{
-						//	fprintf(stderr, "%s[%d]:  nothing for this obj\n", FILE__, __LINE__);
-						continue;
-					}
+					AnnotationClassID id = l->recs[i].id;
 
 					//  we have an annotation of this type for this object, find the serialization
 					//  function and call it (if it exists)
@@ -902,7 +724,7 @@ class COMMON_EXPORT AnnotatableSparse
 
 					ser_rec_t sr;
 					sr.acb = acb;
-					sr.data = iter->second;
+					sr.data = l->recs[i].data;
 					sr.parent_id = (void *) this;
 					sr.sod = sparse;
 					my_sers.push_back(sr);
@@ -929,21 +751,11 @@ class COMMON_EXPORT AnnotatableSparse
 	  void annotationsReport()
 	  {
 		  std::vector<AnnotationClassBase *> atypes;
-		  annos_t &l_annos = *getAnnos();
+		  const anno_list_t *l = annos_.load(std::memory_order_acquire);
 
-		  for (AnnotationClassID id = 0; id < l_annos.size(); ++id)
+		  for (unsigned int i = 0; l && i < l->size; ++i)
 		  {
-			  annos_by_type_t *abt = getAnnosOfType(id, false /*don't do create */);
-			  if (NULL == abt) continue;
-
-			  annos_by_type_t::iterator iter = abt->find(this);
-
-			  if (iter == abt->end()) 
-			  {
-				  //	fprintf(stderr, "%s[%d]:  nothing for this obj\n", FILE__, __LINE__);
-				  continue;
-			  }
-
+			  AnnotationClassID id = l->recs[i].id;
 			  AnnotationClassBase *acb =  AnnotationClassBase::findAnnotationClass(id);
 			  if (!acb)
 			  {
@@ -0,0 +1,186 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _FlatIntervalIndex_h_
+#define _FlatIntervalIndex_h_
+
+#include <assert.h>
+#include <vector>
+#include <algorithm>
+#include "dyntypes.h"
+
+namespace Dyninst {
+
+/** Immutable stabbing-query index over a set of [low, high) intervals.
+  *
+  * Intervals are inserted once and then build() sorts them by start
+  * address into flat parallel arrays.  The start addresses are also laid
+  * out in Eytzinger (BFS) order so the binary search walks a contiguous,
+  * prefetch-friendly array instead of chasing tree pointers.
+  *
+  * Overlap is handled by a nesting side table: parent[i] is the closest
+  * interval before i (in start order) that is still open at low(i).
+  * Every interval that contains an address lies on the parent chain of
+  * the last interval starting at or before it, so a query costs
+  * O(log(N) + L) for properly nested intervals and storage is O(N),
+  * compared to O(N log(N)) for the IBSTree.
+  *
+  * The index is not updated after build(); callers that mutate the
+  * underlying intervals must throw it away and rebuild.
+  **/
+template<class V, class T = Address>
+class FlatIntervalIndex {
+  public:
+    FlatIntervalIndex() : built_(false) { }
+
+    void insert(T low, T high, V value) {
+        assert(!built_);
+        if (low >= high) return;
+        entries_.push_back(entry(low, high, value));
+    }
+
+    void build() {
+        assert(!built_);
+        built_ = true;
+
+        // Sort by start, widest first, so that the innermost of several
+        // intervals sharing a start address is found first.
+        std::sort(entries_.begin(), entries_.end(), entry_cmp());
+
+        unsigned n = entries_.size();
+        lows_.resize(n);
+        highs_.resize(n);
+        values_.resize(n);
+        parent_.resize(n);
+        for (unsigned i = 0; i < n; i++) {
+            lows_[i] = entries_[i].low;
+            highs_[i] = entries_[i].high;
+            values_[i] = entries_[i].value;
+        }
+        std::vector<entry>().swap(entries_);
+
+        // The stack holds candidates with strictly decreasing high
+        // bounds; starts are nondecreasing, so anything that closes at or
+        // before the current start can never be a parent again.
+        std::vector<int> open;
+        for (unsigned i = 0; i < n; i++) {
+            while (!open.empty() && highs_[open.back()] <= lows_[i])
+                open.pop_back();
+            parent_[i] = open.empty() ? -1 : open.back();
+            while (!open.empty() && highs_[open.back()] <= highs_[i])
+                open.pop_back();
+            open.push_back(i);
+        }
+
+        eytzinger_.resize(n + 1);
+        rank_.resize(n + 1);
+        layout(0, 1);
+    }
+
+    bool empty() const { return lows_.empty(); }
+    unsigned size() const { return lows_.size(); }
+
+    /** Find the innermost interval containing addr. */
+    bool find(T addr, V &out) const {
+        for (int i = last_at_or_before(addr); i >= 0; i = parent_[i]) {
+            if (addr < highs_[i]) {
+                out = values_[i];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Find all intervals containing addr, innermost first. */
+    int find(T addr, std::vector<V> &out) const {
+        int found = 0;
+        for (int i = last_at_or_before(addr); i >= 0; i = parent_[i]) {
+            if (addr < highs_[i]) {
+                out.push_back(values_[i]);
+                found++;
+            }
+        }
+        return found;
+    }
+
+  private:
+    struct entry {
+        entry(T l, T h, V v) : low(l), high(h), value(v) { }
+        T low;
+        T high;
+        V value;
+    };
+    struct entry_cmp {
+        bool operator()(const entry &a, const entry &b) const {
+            if (a.low != b.low) return a.low < b.low;
+            return a.high > b.high;
+        }
+    };
+
+    unsigned layout(unsigned i, unsigned k) {
+        if (k <= lows_.size()) {
+            i = layout(i, 2 * k);
+            eytzinger_[k] = lows_[i];
+            rank_[k] = i++;
+            i = layout(i, 2 * k + 1);
+        }
+        return i;
+    }
+
+    // Index (in start order) of the last interval with low <= addr, or -1.
+    int last_at_or_before(T addr) const {
+        unsigned n = lows_.size();
+        unsigned k = 1;
+        while (k <= n)
+            k = 2 * k + (eytzinger_[k] <= addr ? 1 : 0);
+        // Undo the trailing right turns and the final left turn to land on
+        // the first element greater than addr.
+        while (k & 1)
+            k >>= 1;
+        k >>= 1;
+        if (k == 0) return (int) n - 1;
+        return (int) rank_[k] - 1;
+    }
+
+    bool built_;
+    std::vector<entry> entries_;
+
+    std::vector<T> lows_;
+    std::vector<T> highs_;
+    std::vector<V> values_;
+    std::vector<int> parent_;
+
+    std::vector<T> eytzinger_;
+    std::vector<unsigned> rank_;
+};
+
+}
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _SharedFlatMap_h_
+#define _SharedFlatMap_h_
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+namespace Dyninst {
+
+/** Sorted-vector map with copy-on-write storage.
+  *
+  * Entries live in a single contiguous vector ordered by K, so lookups
+  * are a binary search and iteration visits keys in the same order a
+  * std::map would.  Copies share the vector until one side writes to it,
+  * which makes handing a state from one analysis point to the next
+  * (block output to successor input, instruction to instruction) a
+  * pointer copy instead of a tree copy.
+  *
+  * Only the read side of the std::map interface is provided through
+  * iterators; all mutation goes through operator[], set() and erase() so
+  * that sharing is broken exactly when the contents change.
+  **/
+template<class K, class V>
+class SharedFlatMap {
+  public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<K, V> value_type;
+    typedef std::vector<value_type> storage;
+    typedef typename storage::size_type size_type;
+    typedef typename storage::const_iterator const_iterator;
+    typedef const_iterator iterator;
+
+    SharedFlatMap() { }
+
+    /** Adopt entries that are already sorted by key and unique. */
+    explicit SharedFlatMap(storage &&sorted) {
+        if (!sorted.empty())
+            data_ = boost::make_shared<storage>(std::move(sorted));
+    }
+
+    const_iterator begin() const { return entries().begin(); }
+    const_iterator end() const { return entries().end(); }
+    size_type size() const { return data_ ? data_->size() : 0; }
+    bool empty() const { return size() == 0; }
+
+    const_iterator find(const K &k) const {
+        const_iterator i = lower_bound(k);
+        if (i != end() && !(k < i->first)) return i;
+        return end();
+    }
+
+    size_type count(const K &k) const { return find(k) == end() ? 0 : 1; }
+
+    V &operator[](const K &k) {
+        size_type pos = lower_bound(k) - begin();
+        detach();
+        typename storage::iterator i = data_->begin() + pos;
+        if (i == data_->end() || k < i->first)
+            i = data_->insert(i, value_type(k, V()));
+        return i->second;
+    }
+
+    /** Store v under k; leaves shared storage alone if nothing changes. */
+    void set(const K &k, const V &v) {
+        const_iterator c = lower_bound(k);
+        if (c != end() && !(k < c->first) && c->second == v) return;
+        size_type pos = c - begin();
+        detach();
+        typename storage::iterator i = data_->begin() + pos;
+        if (i == data_->end() || k < i->first)
+            data_->insert(i, value_type(k, v));
+        else
+            i->second = v;
+    }
+
+    size_type erase(const K &k) {
+        const_iterator c = find(k);
+        if (c == end()) return 0;
+        size_type pos = c - begin();
+        detach();
+        data_->erase(data_->begin() + pos);
+        return 1;
+    }
+
+    void clear() { data_.reset(); }
+
+    void swap(SharedFlatMap &other) { data_.swap(other.data_); }
+
+    /** True if both maps refer to the same storage. */
+    bool shares(const SharedFlatMap &other) const {
+        return data_ == other.data_;
+    }
+
+    bool operator==(const SharedFlatMap &other) const {
+        if (data_ == other.data_) return true;
+        return entries() == other.entries();
+    }
+    bool operator!=(const SharedFlatMap &other) const {
+        return !(*this == other);
+    }
+
+  private:
+    struct key_less {
+        bool operator()(const value_type &e, const K &k) const {
+            return e.first < k;
+        }
+    };
+
+    static const storage &empty_storage() {
+        static const storage empty;
+        return empty;
+    }
+
+    const storage &entries() const {
+        return data_ ? *data_ : empty_storage();
+    }
+
+    const_iterator lower_bound(const K &k) const {
+        return std::lower_bound(begin(), end(), k, key_less());
+    }
+
+    void detach() {
+        if (!data_)
+            data_ = boost::make_shared<storage>();
+        else if (data_.use_count() != 1)
+            data_ = boost::make_shared<storage>(*data_);
+    }
+
+    boost::shared_ptr<storage> data_;
+};
+
+}
+
+#endif
@@ -33,4 +33,24 @@
 #define SHA1_DIGEST_LEN 20
 #define SHA1_STRING_LEN (SHA1_DIGEST_LEN * 2 + 1)
 char *sha1_file(const char *filename, char *result_ptr = NULL);
+
+#include "common/h/util.h"
+#include "common/src/Types.h"
+
+typedef struct {
+    uint32_t state[5];
+    uint32_t count[2];
+    unsigned char buffer[64];
+} SHA1_CTX;
+
+// Incremental SHA1 over in-memory data. Unlike SHA1Update, the
+// input buffers are never written to, so read-only mappings are fine.
+class COMMON_EXPORT SHA1Hasher {
+    SHA1_CTX ctx;
+ public:
+    SHA1Hasher();
+    void update(const void *data, unsigned long len);
+    // Writes the hex digest (SHA1_STRING_LEN bytes) to result
+    char *finish(char *result);
+};
 #endif
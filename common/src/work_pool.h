@@ -0,0 +1,147 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(WORK_POOL_H_)
+#define WORK_POOL_H_
+
+#include <deque>
+#include <vector>
+#include <stdlib.h>
+
+#include <boost/function.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+/*
+ * A small work-stealing pool for analysis passes whose items are
+ * independent of one another. Items are dealt round-robin onto
+ * per-worker deques; each worker pops from the back of its own deque
+ * and, once that is empty, steals from the front of a peer's. The
+ * calling thread acts as worker 0, so a pool of one thread runs every
+ * item inline, in order.
+ */
+template <typename T>
+class WorkPool {
+ public:
+   typedef boost::function<void (T &)> task_t;
+
+   WorkPool(unsigned nthreads) : nthreads_(nthreads ? nthreads : 1) { }
+
+   unsigned threads() const { return nthreads_; }
+
+   void run(std::vector<T> &items, task_t task)
+   {
+      if (items.empty())
+         return;
+      unsigned nworkers = nthreads_;
+      if (nworkers > items.size())
+         nworkers = items.size();
+      if (nworkers <= 1) {
+         for (unsigned i = 0; i < items.size(); ++i)
+            task(items[i]);
+         return;
+      }
+
+      std::vector<worker_queue> queues(nworkers);
+      for (unsigned i = 0; i < items.size(); ++i)
+         queues[i % nworkers].items.push_back(&items[i]);
+
+      boost::thread_group workers;
+      for (unsigned i = 1; i < nworkers; ++i)
+         workers.create_thread(boost::bind(&WorkPool<T>::work, &queues, i, task));
+      work(&queues, 0, task);
+      workers.join_all();
+   }
+
+   /*
+    * Thread count from the environment variable `var', or `dflt' if it
+    * is unset or malformed. A value of 0 means one thread per core.
+    */
+   static unsigned threadsFromEnv(const char *var, unsigned dflt)
+   {
+      const char *val = getenv(var);
+      if (!val)
+         return dflt;
+      char *end = NULL;
+      long n = strtol(val, &end, 10);
+      if (end == val || n < 0)
+         return dflt;
+      if (n == 0) {
+         n = boost::thread::hardware_concurrency();
+         if (n == 0)
+            n = 1;
+      }
+      return (unsigned) n;
+   }
+
+ private:
+   struct worker_queue {
+      boost::mutex lock;
+      std::deque<T *> items;
+      worker_queue() { }
+      worker_queue(const worker_queue &o) : items(o.items) { }
+   };
+
+   static T *take(std::vector<worker_queue> *queues, unsigned self)
+   {
+      {
+         worker_queue &mine = (*queues)[self];
+         boost::lock_guard<boost::mutex> g(mine.lock);
+         if (!mine.items.empty()) {
+            T *ret = mine.items.back();
+            mine.items.pop_back();
+            return ret;
+         }
+      }
+      for (unsigned i = 1; i < queues->size(); ++i) {
+         worker_queue &victim = (*queues)[(self + i) % queues->size()];
+         boost::lock_guard<boost::mutex> g(victim.lock);
+         if (!victim.items.empty()) {
+            T *ret = victim.items.front();
+            victim.items.pop_front();
+            return ret;
+         }
+      }
+      return NULL;
+   }
+
+   static void work(std::vector<worker_queue> *queues, unsigned self, task_t task)
+   {
+      T *item;
+      while ((item = take(queues, self)) != NULL)
+         task(*item);
+   }
+
+   unsigned nthreads_;
+};
+
+#endif
@@ -40,4 +40,64 @@ typedef boost::dynamic_bitset<unsigned long, std::allocator<unsigned long> > bit
 #define SPEC_FPR_BIT(x) (x.size() - 2)
 #define SPEC_SPR_BIT(x) (x.size() - 1)
 #define SPEC_BIT_COUNT 3
+
+// Fixed-width register set for the liveness dataflow.  Every ABI register
+// index map fits in 256 bits, so the sets live inline with no allocation and
+// the word loops below compile to a few vector instructions.
+class liveBits {
+ public:
+   static const unsigned words = 4;
+   static const unsigned capacity = words * 64;
+
+   liveBits() { clear(); }
+   explicit liveBits(const bitArray &b) {
+      clear();
+      for (bitArray::size_type i = b.find_first(); i != bitArray::npos; i = b.find_next(i))
+         set(i);
+   }
+
+   void clear() {
+      for (unsigned i = 0; i < words; i++) w[i] = 0;
+   }
+   bool test(unsigned i) const { return (w[i / 64] >> (i % 64)) & 1; }
+   void set(unsigned i) { w[i / 64] |= 1ULL << (i % 64); }
+
+   liveBits &operator|=(const liveBits &o) {
+      for (unsigned i = 0; i < words; i++) w[i] |= o.w[i];
+      return *this;
+   }
+   liveBits &operator&=(const liveBits &o) {
+      for (unsigned i = 0; i < words; i++) w[i] &= o.w[i];
+      return *this;
+   }
+   liveBits operator|(const liveBits &o) const { liveBits r(*this); return r |= o; }
+   liveBits operator&(const liveBits &o) const { liveBits r(*this); return r &= o; }
+   liveBits operator~() const {
+      liveBits r;
+      for (unsigned i = 0; i < words; i++) r.w[i] = ~w[i];
+      return r;
+   }
+   // Set difference, as bitArray's operator-
+   liveBits operator-(const liveBits &o) const {
+      liveBits r;
+      for (unsigned i = 0; i < words; i++) r.w[i] = w[i] & ~o.w[i];
+      return r;
+   }
+   bool operator==(const liveBits &o) const {
+      for (unsigned i = 0; i < words; i++)
+         if (w[i] != o.w[i]) return false;
+      return true;
+   }
+   bool operator!=(const liveBits &o) const { return !(*this == o); }
+
+   bitArray toBitArray(bitArray::size_type size) const {
+      bitArray r(size);
+      for (bitArray::size_type i = 0; i < size; i++)
+         if (test(i)) r[i] = true;
+      return r;
+   }
+
+ private:
+   unsigned long long w[words];
+};
 #endif
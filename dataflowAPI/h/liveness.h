@@ -37,47 +37,78 @@
 #include "Instruction.h"
 #include "Register.h"
 #include "InstructionDecoder.h"
-#include "InstructionCache.h"
 #include "bitArray.h"
 #include "ABI.h"
 #include <map>
 #include <set>
+#include <vector>
 
 
 using namespace Dyninst;
 using namespace Dyninst::InstructionAPI;
 
 struct livenessData{
-	bitArray in, out, use, def;
+	liveBits in, out, use, def;
+};
+
+// Register effects of a single instruction
+struct insnLiveness{
+	liveBits read, written;
+	unsigned size;
 };
 
 class DATAFLOW_EXPORT LivenessAnalyzer{
-	std::map<ParseAPI::Block*, livenessData> blockLiveInfo;
-	std::map<ParseAPI::Function*, bool> liveFuncCalculated;
-        std::map<ParseAPI::Function*, bitArray> funcRegsDefined;
-	InstructionCache cachedLivenessInfo;
-
-	const bitArray& getLivenessIn(ParseAPI::Block *block);
-	const bitArray& getLivenessOut(ParseAPI::Block *block, bitArray &allRegsDefined);
-	void processEdgeLiveness(ParseAPI::Edge* e, livenessData& data, ParseAPI::Block* block, const bitArray& allRegsDefined);
-	
-	void summarizeBlockLivenessInfo(ParseAPI::Function* func, ParseAPI::Block *block, bitArray &allRegsDefined);
-	bool updateBlockLivenessInfo(ParseAPI::Block *block, bitArray &allRegsDefined);
-	
-	ReadWriteInfo calcRWSets(Instruction::Ptr curInsn, ParseAPI::Block* blk, Address a);
+	// Block results are stored densely, indexed through blockIDs
+	dyn_hash_map<ParseAPI::Block*, unsigned> blockIDs;
+	std::vector<livenessData> blockLiveInfo;
+	dyn_hash_map<ParseAPI::Function*, liveBits> funcRegsDefined;
+
+	// Live-in at each function's entry, recorded by the whole-CodeObject
+	// analysis and used to refine the registers read by calls to it
+	dyn_hash_map<ParseAPI::Function*, liveBits> callSummaries;
+	dyn_hash_map<ParseAPI::Block*, ParseAPI::Function*> entryFuncs;
+
+	// Per-instruction effects for the blocks of the function last queried
+	ParseAPI::Function *insnCacheFunc;
+	dyn_hash_map<ParseAPI::Block*, std::vector<insnLiveness> > insnCache;
+
+	struct funcLiveness{
+		ParseAPI::Function *func;
+		std::vector<ParseAPI::Block*> blocks;
+		std::vector<livenessData> data;
+		liveBits regsDefined;
+	};
+
+	livenessData *findBlockData(ParseAPI::Block *block);
+	void computeFunction(funcLiveness &result) const;
+	void storeFunction(const funcLiveness &result);
+	void summarizeBlockLivenessInfo(ParseAPI::Block *block, livenessData &data, liveBits &allRegsDefined) const;
+	const std::vector<insnLiveness> &getInsnLiveness(ParseAPI::Function *func, ParseAPI::Block *block);
+
+	insnLiveness calcRWSets(Instruction::Ptr curInsn, ParseAPI::Block* blk, Address a) const;
+	liveBits callReadRegisters(ParseAPI::Block *blk) const;
+	void setFlags(liveBits &regs) const;
 
 	void* getPtrToInstruction(ParseAPI::Block *block, Address addr) const;	
-	bool isExitBlock(ParseAPI::Block *block);
-	bool isMMX(MachRegister machReg);
-	MachRegister changeIfMMX(MachRegister machReg);
+	bool isExitBlock(ParseAPI::Block *block) const;
+	bool isMMX(MachRegister machReg) const;
+	MachRegister changeIfMMX(MachRegister machReg) const;
 	int width;
 	ABI* abi;
+	unsigned numRegs;
+	liveBits callRead, callWritten, returnRead, syscallRead, syscallWritten;
 
 public:
 	typedef enum {Before, After} Type;
 	typedef enum {Invalid_Location} ErrorType;
 	LivenessAnalyzer(int w);
 	void analyze(ParseAPI::Function *func);
+	// Computes liveness for every function in co up front, callees before
+	// callers and functions with no call dependences between them in parallel
+	// on up to threads threads (0 reads DYNINST_LIVENESS_THREADS, default 1).
+	// Each direct call then counts as reading only those argument registers
+	// that are live into its callee, rather than every ABI argument register.
+	void analyze(ParseAPI::CodeObject *co, unsigned threads = 0);
 
 	template <class OutputIterator>
 	bool query(ParseAPI::Location loc, Type type, OutputIterator outIter){
@@ -100,7 +131,7 @@ public:
 	void clean(ParseAPI::Function *func);
 	void clean();
 
-	int getIndex(MachRegister machReg);
+	int getIndex(MachRegister machReg) const;
 	ABI* getABI() { return abi;}
 
 private:
@@ -47,6 +47,7 @@
 #include "dyntypes.h"
 #include "dyn_regs.h"
 #include "util.h"
+#include "SharedFlatMap.h"
 
 // FreeBSD is missing a MINLONG and MAXLONG
 #if defined(os_freebsd) 
@@ -194,7 +195,11 @@ public:
    // they are fixed) and RV as a parameter. Note that a transfer function is a
    // function T : (RegisterVector, RegisterID, RegisterID, value) ->
    // (RegisterVector).
-   typedef std::map<Absloc, Height> AbslocState;
+   //
+   // States are sorted flat maps that share storage until written, so
+   // passing a state along an edge or from one instruction to the next is
+   // cheap when nothing about it changed.
+   typedef SharedFlatMap<Absloc, Height> AbslocState;
    class TransferFunc {
    public:
       typedef enum {TOP, BOTTOM, OTHER} Type;
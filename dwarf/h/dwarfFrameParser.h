@@ -98,6 +98,15 @@ class DYNDWARF_EXPORT DwarfFrameParser {
                            std::vector<VariableLocation> &locs,
                            FrameErrors_t &err_result);
 
+   // When enabled, the first query builds a table of every CFI row in
+   // the object, with the CFA, return address and frame pointer rules
+   // already decoded. Queries for those registers then binary-search
+   // the table instead of going through libdwarf. Rules that need a
+   // DWARF expression still take the libdwarf path. Parsers are shared
+   // per Dwarf_Debug by create(), so each object builds its table once.
+   // Off by default; DYNINST_DWARF_UNWIND_TABLE=1 turns it on.
+   static void setUseUnwindTable(bool value);
+
 
   private:
 
@@ -155,6 +164,54 @@ class DYNDWARF_EXPORT DwarfFrameParser {
    std::vector<fde_cie_data> fde_data;
    void setupFdeData();
 
+   typedef enum {
+      cfi_undefined,
+      cfi_same_value,
+      cfi_cfa,        // relative to the CFA
+      cfi_register,   // relative to a machine register
+      cfi_expression  // not precompiled; use libdwarf
+   } cfi_kind_t;
+
+   static const unsigned char cfi_add = 1;
+   static const unsigned char cfi_deref = 2;
+
+   struct cfi_rule {
+      unsigned char kind;
+      unsigned char flags;
+      Dwarf_Half reg;
+      int offset;
+   };
+
+   // One row of the CFI table, covering [low, high]
+   struct cfi_row {
+      Address low;
+      Address high;
+      cfi_rule cfa;
+      cfi_rule ra;
+      cfi_rule fp;
+   };
+
+   struct cfi_row_less {
+      bool operator()(const cfi_row &a, const cfi_row &b) const { return a.low < b.low; }
+      bool operator()(Address a, const cfi_row &b) const { return a < b.low; }
+   };
+
+   static bool useUnwindTable;
+   dwarf_status_t cfi_status;
+   bool cfi_complete;
+   std::vector<cfi_row> cfi_rows;
+
+   void setupUnwindTable();
+   bool addUnwindRows(Dwarf_Fde fde, Dwarf_Half fp_reg,
+                      std::vector<cfi_row> &rows);
+   bool getUnwindRule(Dwarf_Fde fde, Dwarf_Half dwarf_reg, Address pc,
+                      cfi_rule &rule, Address &row_low);
+   bool overlapsUnwindRow(Address low, Address high) const;
+   const cfi_row *findUnwindRow(Address pc) const;
+   bool getRegFromTable(Address pc, MachRegister reg,
+                        DwarfResult &cons, bool &handled,
+                        FrameErrors_t &err_result);
+
 
 
 };
@@ -156,6 +156,11 @@ class BPATCH_DLL_EXPORT BPatch {
     /* How far through the CFG do we follow calls? */
     int livenessAnalysisDepth_;
 
+    /* If true, calls from instrumentation to small straight-line leaf
+       functions are replaced with a copy of the function's body.
+       Defaults to false. */
+    bool inlineLeafCallsOn_;
+
     /* If true, override requests to block while waiting for events,
        polling instead */
     bool asyncActive;
@@ -334,6 +339,11 @@ public:
     
                int livenessAnalysisDepth();
 
+    // BPatch::inlineLeafCallsOn:
+    // returns whether small leaf callees are inlined into instrumentation
+
+    bool inlineLeafCallsOn();
+
 
     //  User-specified callback functions...
 
@@ -538,6 +548,11 @@ public:
     
                  void  setLivenessAnalysisDepth(int x);
 
+    //  BPatch::setInlineLeafCalls:
+    //  Turn on/off inlining of small leaf callees into instrumentation
+
+    void setInlineLeafCalls(bool x);
+
     // BPatch::processCreate:
     // Create a new mutatee process
     
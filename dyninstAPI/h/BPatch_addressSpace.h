@@ -150,6 +150,8 @@ class BPATCH_DLL_EXPORT BPatch_addressSpace {
   friend class BPatch_loopTreeNode;
   friend class BPatch_point;
   friend class BPatch_funcCallExpr;
+  friend class BPatch_threadCounterExpr;
+  friend class BPatch_threadRingExpr;
   friend class BPatch_eventMailbox;
   friend class BPatch_instruction;
   friend Dyninst::PatchAPI::PatchMgrPtr Dyninst::PatchAPI::convert(const BPatch_addressSpace *);
@@ -347,6 +347,37 @@ class BPATCH_DLL_EXPORT BPatch_process : public BPatch_addressSpace {
   //  this process
   void  getThreads(BPatch_Vector<BPatch_thread *> &thrds);
 
+  //  BPatch_process::getThreadCounterTotals
+  //
+  //  Sums the BPatch_threadCounterExpr counters over the live threads.
+  //  Threads that have already exited are not counted.
+  bool  getThreadCounterTotals(BPatch_Vector<unsigned long long> &totals);
+
+  //  BPatch_process::createEventRing
+  //
+  //  Has the runtime library set up a shared-memory ring of numRecords
+  //  records (a power of two), each recordWords 64-bit words long, and
+  //  maps it into the mutator.  Records are appended with
+  //  BPatch_eventRecordExpr.
+  bool  createEventRing(unsigned recordWords, unsigned numRecords);
+
+  //  BPatch_process::peekEventRecord
+  //
+  //  Returns the oldest unread record in place in the shared ring, or
+  //  NULL if none is ready.  Does not require the process to be stopped.
+  //  The mutatee shares the memory, so the record is volatile.
+  const volatile unsigned long long *peekEventRecord();
+
+  //  BPatch_process::releaseEventRecord
+  //
+  //  Hands the record returned by peekEventRecord back to the mutatee
+  void  releaseEventRecord();
+
+  //  BPatch_process::droppedEventRecords
+  //
+  //  Number of records the mutatee discarded because the ring was full
+  unsigned long long droppedEventRecords();
+
   //  BPatch_prOcess::isMultithreaded
   //
   //  Returns true if this process has more than one thread
@@ -414,6 +445,11 @@ class BPATCH_DLL_EXPORT BPatch_process : public BPatch_addressSpace {
   //            steps were taken to make the installation work, such as modifying
   //            process state.  Note that such steps will be taken whether or not
   //            a variable is provided.
+  //
+  //  Every function with a point whose snippet list changed is relocated
+  //  again in full. Insertions and removals that cancel out within the same
+  //  set are ignored; enabling a snippet in one set and removing it in a
+  //  later one costs two full relocations of its function.
 
   bool  finalizeInsertionSet(bool atomic, bool *modified = NULL);
                                        
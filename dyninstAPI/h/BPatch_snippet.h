@@ -550,6 +550,40 @@ class BPATCH_DLL_EXPORT BPatch_threadIndexExpr : public BPatch_snippet {
   BPatch_threadIndexExpr();
 };
 
+// Per-thread counters and ring buffer held in the runtime library's TLS.
+// The generated code addresses the running thread's copy through the
+// thread pointer, so it takes no lock and makes no call; read the results
+// with BPatch_thread::getThreadCounters and friends. Only x86_64 Linux
+// and FreeBSD mutatees are supported.
+
+class BPATCH_DLL_EXPORT BPatch_threadCounterExpr : public BPatch_snippet {
+ public:
+  //
+  // BPatch_threadCounterExpr::BPatch_threadCounterExpr
+  //  Add delta to the running thread's counter number 'counter'
+  BPatch_threadCounterExpr(BPatch_addressSpace *as, unsigned counter,
+                           const BPatch_snippet &delta);
+};
+
+class BPATCH_DLL_EXPORT BPatch_threadRingExpr : public BPatch_snippet {
+ public:
+  //
+  // BPatch_threadRingExpr::BPatch_threadRingExpr
+  //  Append value to the running thread's ring buffer
+  BPatch_threadRingExpr(BPatch_addressSpace *as, const BPatch_snippet &value);
+};
+
+class BPATCH_DLL_EXPORT BPatch_eventRecordExpr : public BPatch_snippet {
+ public:
+  //
+  // BPatch_eventRecordExpr::BPatch_eventRecordExpr
+  //  Append a record of up to five word-sized fields to the process's
+  //  event ring (see BPatch_process::createEventRing); each is stored
+  //  zero-extended to 64 bits, and missing fields are zero
+  BPatch_eventRecordExpr(BPatch_addressSpace *as,
+                         const BPatch_Vector<BPatch_snippet *> &fields);
+};
+
 class BPATCH_DLL_EXPORT BPatch_tidExpr : public BPatch_snippet {
  public:
   //
@@ -112,6 +112,16 @@ class BPATCH_DLL_EXPORT BPatch_thread {
     //  BPatch_thread::oneTimeCodeAsync
     //  Have mutatee execute specified code expr once.  Dont wait until done.
     bool oneTimeCodeAsync(const BPatch_snippet &expr, void *userData = NULL, BPatchOneTimeCodeCallback cb = NULL);
+
+    //  BPatch_thread::getThreadCounters
+    //  Read this thread's BPatch_threadCounterExpr counters.  The process
+    //  must be stopped.
+    bool getThreadCounters(BPatch_Vector<unsigned long long> &counters);
+
+    //  BPatch_thread::getThreadRing
+    //  Read the values this thread logged with BPatch_threadRingExpr,
+    //  oldest first.  The process must be stopped.
+    bool getThreadRing(BPatch_Vector<unsigned long long> &values);
 };
 
 #endif /* BPatch_thread_h_ */
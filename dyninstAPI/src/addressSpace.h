@@ -482,6 +482,13 @@ class AddressSpace : public InstructionSource {
 
     void addModifiedFunction(func_instance *func);
     void addModifiedBlock(block_instance *block);
+    // Call before changing a point's snippet list. At the next relocation
+    // the point's function is moved again unless the list is back to what
+    // it was when this was first called, i.e. only edits that cancel out
+    // within one batch are skipped. A snippet removed in a later batch
+    // still regenerates the whole function.
+    void addModifiedPoint(instPoint *point);
+    void removeModifiedPoint(instPoint *point);
 
     void updateMemEmulator();
     bool isMemoryEmulated() { return emulateMem_; }
@@ -528,6 +535,12 @@ class AddressSpace : public InstructionSource {
     typedef std::set<func_instance *> FuncSet;
     std::map<mapped_object *, FuncSet> modifiedFunctions_;
 
+    // Snippet lists of modified points as they were when their code was
+    // last generated. Holding the instances keeps pointer comparison honest.
+    typedef std::vector<Dyninst::PatchAPI::InstancePtr> InstanceSnapshot;
+    std::map<instPoint *, InstanceSnapshot> modifiedPoints_;
+    void resolveModifiedPoints();
+
     bool relocateInt(FuncSet::const_iterator begin, FuncSet::const_iterator end, Address near);
     Dyninst::Relocation::InstalledSpringboards::Ptr installedSpringboards_;
  public:
@@ -162,6 +162,7 @@ class AstNode : public Dyninst::PatchAPI::Snippet {
                       origRegister,
                       variableAddr,
                       variableValue,
+                      ThreadPointer, // The running thread's TLS base
                       undefOperandType };
 
 
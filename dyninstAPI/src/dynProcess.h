@@ -247,6 +247,13 @@ public:
     bool isExploratoryModeOn() const;
 
     bool hideDebugger(); // platform-specific
+
+    // Shared-memory event ring (see DYNINSTringCreate in the RT library)
+    bool attachEventRing(); // platform-specific
+    void detachEventRing(); // platform-specific
+    const volatile uint64_t *peekEventRecord(); // platform-specific
+    void releaseEventRecord(); // platform-specific
+    DYNINST_ring_header_t *eventRing() const { return eventRing_; }
     void flushAddressCache_RT(Address start = 0, unsigned size = 0);
     void flushAddressCache_RT(codeRange *range) { 
         flushAddressCache_RT(range->get_address(), range->get_size());
@@ -360,6 +367,10 @@ protected:
           eventHandler_(NULL),
           eventCount_(0),
           tracedSyscalls_(NULL),
+          eventRing_(NULL),
+          eventRingSize_(0),
+          eventRingWords_(0),
+          eventRingCapacity_(0),
           mt_cache_result_(not_cached),
           isInDebugSuicide_(false),
           irpcTramp_(NULL),
@@ -400,6 +411,10 @@ protected:
           eventHandler_(NULL),
           eventCount_(0),
           tracedSyscalls_(NULL),
+          eventRing_(NULL),
+          eventRingSize_(0),
+          eventRingWords_(0),
+          eventRingCapacity_(0),
           mt_cache_result_(not_cached),
           isInDebugSuicide_(false),
           irpcTramp_(NULL),
@@ -443,6 +458,10 @@ protected:
           eventHandler_(parent->eventHandler_),
           eventCount_(0),
           tracedSyscalls_(NULL), // filled after construction
+          eventRing_(NULL),
+          eventRingSize_(0),
+          eventRingWords_(0),
+          eventRingCapacity_(0),
           mt_cache_result_(parent->mt_cache_result_),
           isInDebugSuicide_(parent->isInDebugSuicide_),
           inEventHandling_(false),
@@ -604,6 +623,14 @@ protected:
 
     syscallNotification *tracedSyscalls_;
 
+    // Our mapping of the RT library's event ring
+    DYNINST_ring_header_t *eventRing_;
+    size_t eventRingSize_;
+    // Validated at attach; the header itself is writable by the mutatee
+    unsigned eventRingWords_;
+    uint64_t eventRingCapacity_;
+    volatile uint64_t *eventRingSlot(uint64_t pos) const;
+
     mt_cache_result_t mt_cache_result_;
 
     bool isInDebugSuicide_; // Single stepping is only valid in this context
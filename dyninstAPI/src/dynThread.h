@@ -59,6 +59,9 @@ public:
     bool getRegisters(ProcControlAPI::RegisterPool &regs, bool includeFP = false);
     bool changePC(Address newPC);
 
+    // Copies out this thread's DYNINST_tls_block (see BPatch_threadCounterExpr)
+    bool readTLSBlock(DYNINST_tls_block_t &block);
+
     // Field accessors
     int getIndex() const;
     Dyninst::LWP getLWP() const;
@@ -109,6 +109,10 @@ class Emitter {
     
     virtual bool clobberAllFuncCall(registerSpace *rs,func_instance *callee) = 0;
 
+    // Load the running thread's TLS base (the thread pointer); false if we
+    // don't know how on this platform.
+    virtual bool emitLoadThreadPointer(Register, codeGen &) { return false; }
+
     Address getInterModuleFuncAddr(func_instance *func, codeGen& gen);
     Address getInterModuleVarAddr(const image_variable *var, codeGen& gen);
     //bool emitPIC(codeGen& /*gen*/, Address, Address );
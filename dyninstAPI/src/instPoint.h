@@ -75,6 +75,7 @@ class instPoint : public Dyninst::PatchAPI::Point {
   friend class block_instance;
   friend class edge_instance;
   friend class DynPointMaker;
+  friend class AddressSpace;
   public:
 
     // The compleat list of instPoint creation methods
@@ -157,6 +158,8 @@ class instPoint : public Dyninst::PatchAPI::Point {
                           Address a);
 
     baseTramp *baseTramp_;
+    // Set while the point is in this address space's modifiedPoints_
+    AddressSpace *modifiedBy_;
 };
 
 #define IPCONV(p) (static_cast<instPoint *>(p))
@@ -380,6 +380,20 @@ class parse_func : public ParseAPI::Function
    bool writesFPRs(unsigned level = 0);
    bool writesSPRs(unsigned level = 0);
 
+   // Registers (as ABI liveness indices) this function, or anything it
+   // calls, may write; every register if we can't tell. Cached.
+   const bitArray &writtenRegs();
+
+   // The body, minus its return, of a small straight-line leaf that can be
+   // pasted into a tramp in place of a call to it; NULL if it can't be.
+   struct InlineInsn {
+      Offset off;
+      InstructionAPI::Instruction::Ptr insn;
+      Offset pcRelTarget;  // Data target of a PC-relative operand, else 0
+   };
+   typedef std::vector<InlineInsn> InlineBody;
+   const InlineBody *inlineBody();
+
 
    void invalidateLiveness() { livenessCalculated_ = false; }
    void calcBlockLevelLiveness();
@@ -387,6 +401,8 @@ class parse_func : public ParseAPI::Function
    const SymtabAPI::Function *func() const { return func_; }
 
  private:
+   bool calcWrittenRegs(bitArray &written, unsigned level);
+   bool calcInlineBody();
    void calcUsedRegs();/* Does one time calculation of registers used in a function, if called again
                           it just refers to the stored values and returns that */
 
@@ -402,6 +418,10 @@ class parse_func : public ParseAPI::Function
    parse_func_registers * usedRegisters;
    regUseState containsFPRWrites_;   // floating point registers
    regUseState containsSPRWrites_;   // stack pointer registers
+   regUseState writtenRegsState_;    // writtenRegs_ is valid if not unknown
+   bitArray writtenRegs_;
+   regUseState inlineable_;          // used if inlineBody_ is valid
+   InlineBody inlineBody_;
 
    ///////////////////// CFG and function body
    bool containsSharedBlocks_;  // True if one or more blocks in this
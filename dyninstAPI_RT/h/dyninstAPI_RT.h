@@ -87,6 +87,57 @@ extern int DYNINSTdebugPrintRT; /* control run-time lib debug/trace prints */
 #define TARGET_CACHE_WIDTH 128
 #define TARGET_CACHE_WAYS 2
 
+/* Per-thread counters and ring buffer, kept in the runtime library's static
+ * TLS.  Instrumentation reaches the running thread's copy at the thread
+ * pointer plus DYNINST_tls_block_offset, without a lock or a call; the
+ * mutator sums the counters over threads.  Static TLS is scarce, so keep
+ * this small. */
+#define DYNINST_TLS_COUNTERS 16
+#define DYNINST_TLS_RING_SIZE 16 /* must be a power of two */
+typedef struct {
+   uint64_t counters[DYNINST_TLS_COUNTERS];
+   uint64_t ring_next; /* total appends; next slot is ring_next % size */
+   uint64_t ring[DYNINST_TLS_RING_SIZE];
+} DYNINST_tls_block_t;
+
+/* Event ring shared between the mutatee and the mutator.  The runtime
+ * library maps it from a file (see DYNINST_RING_NAME_FMT) that the mutator
+ * maps as well, so records never pass through ptrace or the async socket.
+ * Any number of mutatee threads append; the mutator is the only reader.
+ * Each slot is a sequence word followed by `words' payload words: slot i
+ * holds sequence i while free, pos+1 once the record claimed at pos is
+ * written, and pos+capacity once the mutator has consumed it. */
+#define DYNINST_RING_MAGIC 0x474e5244 /* "DRNG" */
+#define DYNINST_RING_MAX_WORDS 5
+#define DYNINST_RING_PATH_LENGTH 256
+/* The ring file is DYNINST_RING_DIR/dyninstRing.<mutator pid>.<mutatee pid>;
+ * both sides build the name themselves rather than trust the other's. */
+#if defined(os_linux)
+#define DYNINST_RING_DIR "/dev/shm"
+#else
+#define DYNINST_RING_DIR P_tmpdir
+#endif
+#define DYNINST_RING_NAME_FMT "%s/dyninstRing.%d.%d"
+typedef struct {
+   uint32_t magic;
+   uint32_t words;      /* payload words per record */
+   uint64_t capacity;   /* slots; a power of two */
+   volatile uint64_t dropped; /* appends lost because the ring was full */
+   uint64_t pad0[5];
+   volatile uint64_t head; /* next position producers claim */
+   uint64_t pad1[7];
+   volatile uint64_t tail; /* next position the mutator reads */
+   uint64_t pad2[7];
+} DYNINST_ring_header_t;
+
+#define DYNINST_RING_SLOT(ring, pos) \
+   ((volatile uint64_t *) ((char *) (ring) + sizeof(DYNINST_ring_header_t) + \
+                           ((pos) & ((ring)->capacity - 1)) * \
+                           (((ring)->words + 1) * sizeof(uint64_t))))
+#define DYNINST_RING_BYTES(words, capacity) \
+   (sizeof(DYNINST_ring_header_t) + \
+    (size_t) (capacity) * (((words) + 1) * sizeof(uint64_t)))
+
 #define THREAD_AWAITING_DELETION -2
 
 #define ERROR_STRING_LENGTH 256
@@ -140,6 +140,22 @@ DLLEXPORT void DYNINST_unlock_tramp_guard()
   DYNINST_tls_tramp_guard = 1;
 }
 
+static TLS_VAR DYNINST_tls_block_t DYNINST_tls_block;
+
+// Offset of DYNINST_tls_block from the thread pointer; the same for every
+// thread.  Zero until DYNINSTBaseInit fills it in, which instrumentation
+// takes to mean the block isn't reachable yet.
+DLLEXPORT long DYNINST_tls_block_offset = 0;
+
+static void initTLSBlockOffset()
+{
+#if (defined(os_linux) || defined(os_freebsd)) && defined(arch_x86_64)
+   char *tp;
+   __asm__ __volatile__ ("mov %%fs:0, %0" : "=r" (tp));
+   DYNINST_tls_block_offset = (char *) &DYNINST_tls_block - tp;
+#endif
+}
+
 #if defined(os_linux)
 void DYNINSTlinuxBreakPoint();
 #endif
@@ -169,6 +185,7 @@ void DYNINSTBaseInit()
    DYNINSTinitializeTrapHandler();
 #endif
    DYNINST_unlock_tramp_guard();
+   initTLSBlockOffset();
    DYNINSThasInitialized = 1;
 
    RTuntranslatedEntryCounter = 0;
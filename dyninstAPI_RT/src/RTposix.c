@@ -286,3 +286,101 @@ int DYNINSTinitializeTrapHandler()
 }
 
 #endif
+
+/* Event ring; see DYNINST_ring_header_t.  The mutator creates it with a
+ * oneTimeCode call to DYNINSTringCreate, passing its own pid, then maps the
+ * file by a name it builds itself. */
+DLLEXPORT DYNINST_ring_header_t *DYNINST_ring = NULL;
+
+int DYNINSTringCreate(unsigned words, unsigned capacity, int mutatorPid)
+{
+   DYNINST_ring_header_t *ring;
+   char path[DYNINST_RING_PATH_LENGTH];
+   size_t size;
+   uint64_t i;
+   int fd;
+
+   if (DYNINST_ring)
+      return 0;
+   if (words == 0 || words > DYNINST_RING_MAX_WORDS)
+      return 0;
+   if (capacity == 0 || (capacity & (capacity - 1)))
+      return 0;
+
+   snprintf(path, sizeof(path), DYNINST_RING_NAME_FMT,
+            DYNINST_RING_DIR, mutatorPid, getpid());
+   /* The name is predictable and the directory world-writable, so refuse
+    * to reuse anything already there, including a planted symlink. */
+   fd = open(path, O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW, 0600);
+   if (fd == -1) {
+      rtdebug_printf("%s[%d]:  open(%s): %s\n", __FILE__, __LINE__,
+                     path, strerror(errno));
+      return 0;
+   }
+
+   size = DYNINST_RING_BYTES(words, capacity);
+   if (ftruncate(fd, size) == -1) {
+      close(fd);
+      unlink(path);
+      return 0;
+   }
+   ring = (DYNINST_ring_header_t *) mmap(NULL, size, PROT_READ|PROT_WRITE,
+                                         MAP_SHARED, fd, 0);
+   close(fd);
+   if (ring == (DYNINST_ring_header_t *) MAP_FAILED) {
+      unlink(path);
+      return 0;
+   }
+
+   ring->words = words;
+   ring->capacity = capacity;
+   for (i = 0; i < capacity; i++)
+      *DYNINST_RING_SLOT(ring, i) = i;
+   ring->magic = DYNINST_RING_MAGIC;
+
+   /* Publish only once the slots are set up */
+   __sync_synchronize();
+   DYNINST_ring = ring;
+   return 1;
+}
+
+/* Called from instrumentation.  A claimed slot is written and then
+ * published by its sequence word; if the mutator has fallen a full ring
+ * behind, the record is counted as dropped rather than waited on. */
+void DYNINSTringAppend(unsigned long w0, unsigned long w1, unsigned long w2,
+                       unsigned long w3, unsigned long w4)
+{
+   DYNINST_ring_header_t *ring = DYNINST_ring;
+   volatile uint64_t *slot;
+   uint64_t pos, seq;
+
+   if (!ring)
+      return;
+
+   pos = ring->head;
+   for (;;) {
+      slot = DYNINST_RING_SLOT(ring, pos);
+      seq = slot[0];
+      if (seq == pos) {
+         if (__sync_bool_compare_and_swap(&ring->head, pos, pos + 1))
+            break;
+         pos = ring->head;
+      }
+      else if ((int64_t) (seq - pos) < 0) {
+         __sync_fetch_and_add(&ring->dropped, 1);
+         return;
+      }
+      else
+         pos = ring->head;
+   }
+
+   switch (ring->words) {
+      case 5: slot[5] = w4;
+      case 4: slot[4] = w3;
+      case 3: slot[3] = w2;
+      case 2: slot[2] = w1;
+      default: slot[1] = w0;
+   }
+   __sync_synchronize();
+   slot[0] = pos + 1;
+}
@@ -0,0 +1,113 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(COMPACT_INSTRUCTION_H)
+#define COMPACT_INSTRUCTION_H
+
+#include <vector>
+#include <string>
+#include "Instruction.h"
+#include "InstructionCategories.h"
+
+namespace Dyninst
+{
+  namespace InstructionAPI
+  {
+    class InstructionDecoderImpl;
+
+    /// A %CompactInstruction is a fixed-size value type holding what a linear sweep needs from
+    /// a decoded instruction: its raw bytes, size, opcode and category.  Decoding into a
+    /// %CompactInstruction with InstructionDecoder::decode(CompactInstruction&) does not build
+    /// an %Operation, %Operands or %Expression ASTs, and on x86 and x86_64 does not allocate at all.
+    ///
+    /// A %CompactInstruction does not store operand descriptors; it is plain data that may be
+    /// copied with memcpy.  \c getInstruction and the operand queries that forward to it decode a
+    /// fresh %Instruction from the stored bytes on every call, so callers that inspect operands
+    /// repeatedly should keep the returned %Instruction.
+    ///
+    /// Records filled in by InstructionDecoder::decode(CompactInstruction*, size_t, Address) also carry
+    /// the target of direct branches and calls, so that a sweep can follow control flow without
+    /// materializing any %Instruction.
+    class CompactInstruction
+    {
+      friend class InstructionDecoderImpl;
+    public:
+      /// Storage for the raw bytes.
+      static const unsigned int maxSize = 16;
+      /// The longest legal machine instruction (the x86 limit), in bytes.  Longer
+      /// decodes, such as a run of prefixes met in data, become an illegal
+      /// instruction of exactly this length.
+      static const unsigned int maxLength = 15;
+
+      INSTRUCTION_EXPORT CompactInstruction();
+      INSTRUCTION_EXPORT CompactInstruction(entryID id, size_t size, const unsigned char* raw,
+                                            Architecture arch);
+      /// Build a %CompactInstruction from an already decoded %Instruction.
+      INSTRUCTION_EXPORT explicit CompactInstruction(Instruction::Ptr insn);
+
+      /// Returns true if this object holds a decoded instruction.
+      INSTRUCTION_EXPORT bool isValid() const;
+      /// Returns true if the decoded bytes form a legal instruction.
+      INSTRUCTION_EXPORT bool isLegalInsn() const;
+
+      INSTRUCTION_EXPORT size_t size() const;
+      INSTRUCTION_EXPORT const void* ptr() const;
+      INSTRUCTION_EXPORT unsigned char rawByte(unsigned int index) const;
+
+      INSTRUCTION_EXPORT entryID getID() const;
+      INSTRUCTION_EXPORT Architecture getArch() const;
+      INSTRUCTION_EXPORT InsnCategory getCategory() const;
+
+      /// Returns true if the absolute target of this direct branch or call was computed when it was decoded.
+      INSTRUCTION_EXPORT bool hasDirectTarget() const;
+      /// Returns the absolute target computed at decode time; only meaningful if \c hasDirectTarget is true.
+      INSTRUCTION_EXPORT Address getDirectTarget() const;
+
+      /// Decodes and returns the full %Instruction.
+      INSTRUCTION_EXPORT Instruction::Ptr getInstruction() const;
+
+      INSTRUCTION_EXPORT void getOperands(std::vector<Operand>& operands) const;
+      INSTRUCTION_EXPORT Operand getOperand(int index) const;
+      INSTRUCTION_EXPORT Expression::Ptr getControlFlowTarget() const;
+      INSTRUCTION_EXPORT std::string format(Address addr = 0) const;
+
+    private:
+      unsigned char m_Raw[maxSize];
+      unsigned char m_size;
+      entryID m_ID;
+      InsnCategory m_Category;
+      Architecture m_Arch;
+      bool m_HasTarget;
+      Address m_Target;
+    };
+  };
+};
+
+#endif //!defined(COMPACT_INSTRUCTION_H)
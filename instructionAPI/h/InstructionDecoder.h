@@ -32,6 +32,7 @@
 #define INSTRUCTION_DECODER_H
 
 #include "Instruction.h"
+#include "CompactInstruction.h"
 
 #if defined(_MSC_VER)
 #pragma warning(disable:4251)
@@ -72,6 +73,16 @@ namespace Dyninst
       /// a null %Instruction pointer will be returned.  The %Instruction's \c size field will contain
       /// the size of the instruction decoded.
       Instruction::Ptr decode(const unsigned char* buffer);
+      /// Decode the current instruction in this %InstructionDecoder object's buffer into \c insn,
+      /// without building its %Operation or %Operands.  Returns false, leaving \c insn invalid, once
+      /// the end of the buffer has been reached.  An undecodable byte sequence yields a valid
+      /// \c insn for which \c isLegalInsn is false.
+      bool decode(CompactInstruction& insn);
+      /// Decode instructions from the current position in this %InstructionDecoder object's buffer into
+      /// the \c max records at \c out, stopping early at the end of the buffer.  \c addr is the address
+      /// of the current position, and is used to fill in the targets of direct branches and calls.
+      /// Returns the number of records written.
+      size_t decode(CompactInstruction* out, size_t max, Address addr);
       void doDelayedDecode(const Instruction* insn_to_complete);
       struct INSTRUCTION_EXPORT buffer
       {
@@ -70,6 +70,9 @@ namespace Dyninst
                 INSTRUCTION_EXPORT InstructionDecoder_x86(const InstructionDecoder_x86& o);
             public:
                 INSTRUCTION_EXPORT virtual Instruction::Ptr decode(InstructionDecoder::buffer& b);
+                virtual bool decodeCompact(InstructionDecoder::buffer& b, CompactInstruction& insn);
+                virtual size_t decodeBlock(InstructionDecoder::buffer& b, CompactInstruction* out, size_t max,
+                                           Address addr);
       
                 INSTRUCTION_EXPORT virtual void setMode(bool is64);
                 virtual void doDelayedDecode(const Instruction* insn_to_complete);
@@ -94,6 +97,7 @@ namespace Dyninst
 
             private:
                 void doIA32Decode(InstructionDecoder::buffer& b);
+                NS_x86::ia32_entry* decodeIA32Entry(InstructionDecoder::buffer& b);
 		bool isDefault64Insn();
 		
                 static TLS_VAR ia32_locations* locs;
@@ -50,6 +50,9 @@ class InstructionDecoderImpl
         InstructionDecoderImpl(Architecture a) : m_Arch(a) {}
         virtual ~InstructionDecoderImpl() {}
         virtual Instruction::Ptr decode(InstructionDecoder::buffer& b);
+        virtual bool decodeCompact(InstructionDecoder::buffer& b, CompactInstruction& insn);
+        virtual size_t decodeBlock(InstructionDecoder::buffer& b, CompactInstruction* out, size_t max,
+                                   Address addr);
         virtual void doDelayedDecode(const Instruction* insn_to_complete) = 0;
         virtual void setMode(bool is64) = 0;
         static Ptr makeDecoderImpl(Architecture a);
@@ -71,13 +74,13 @@ class InstructionDecoderImpl
         virtual Expression::Ptr makeMaskRegisterExpression(MachRegister reg);
         virtual Expression::Ptr makeRegisterExpression(MachRegister reg, Result_Type extendFrom);
         virtual Result_Type makeSizeType(unsigned int opType) = 0;
+        static void setDirectTarget(CompactInstruction& insn, Address target);
         Instruction* makeInstruction(entryID opcode, const char* mnem, unsigned int decodedSize,
                                      const unsigned char* raw);
       
     protected:
         Operation::Ptr m_Operation;
         Architecture m_Arch;
-        static std::map<Architecture, Ptr> impls;
       
 };
 
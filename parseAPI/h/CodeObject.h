@@ -97,6 +97,18 @@ class CodeObject {
     // `speculative' parsing
     PARSER_EXPORT void parseGaps(CodeRegion *cr, GapParsingType type=IdiomMatching);
 
+    // Number of threads used to decode hinted functions during
+    // hint-based parsing. Defaults to DYNINST_PARSE_THREADS, or 1.
+    PARSER_EXPORT void setParseThreads(unsigned nthreads);
+
+    // Persistent CFG cache. saveCache writes the parsed CFG to `file';
+    // loadCache restores an unparsed object from `file' instead of
+    // parsing, provided it was written for the same code bytes and
+    // hints. Setting DYNINST_PARSE_CACHE to a directory does both
+    // automatically during hint-based parsing.
+    PARSER_EXPORT bool saveCache(std::string file);
+    PARSER_EXPORT bool loadCache(std::string file);
+
     /** Lookup routines **/
 
     // functions
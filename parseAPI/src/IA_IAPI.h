@@ -54,12 +54,17 @@ class IA_IAPI : public InstructionAdapter {
     friend class IA_powerDetails;
     friend class IA_aarch64Details;
     public:
+        // Instructions decoded ahead of parsing, keyed by address
+        typedef dyn_hash_map<Address,
+            Dyninst::InstructionAPI::Instruction::Ptr> decodeCache_t;
+
         IA_IAPI(Dyninst::InstructionAPI::InstructionDecoder dec_,
                 Address start_, 
                 Dyninst::ParseAPI::CodeObject* o,
                 Dyninst::ParseAPI::CodeRegion* r,
                 Dyninst::InstructionSource *isrc,
-		Dyninst::ParseAPI::Block * curBlk_);
+		Dyninst::ParseAPI::Block * curBlk_,
+                const decodeCache_t *cache = NULL);
                 // We have a iterator, and so can't use the implicit copiers
 		IA_IAPI(const IA_IAPI &); 
 		IA_IAPI &operator=(const IA_IAPI &r);
@@ -68,7 +73,8 @@ class IA_IAPI : public InstructionAdapter {
         }
         void reset(Dyninst::InstructionAPI::InstructionDecoder dec_,
           Address start, ParseAPI::CodeObject *o,
-          ParseAPI::CodeRegion *r, InstructionSource *isrc, ParseAPI::Block *);
+          ParseAPI::CodeRegion *r, InstructionSource *isrc, ParseAPI::Block *,
+          const decodeCache_t *cache = NULL);
 
         virtual Dyninst::InstructionAPI::Instruction::Ptr getInstruction() const;
     
@@ -134,6 +140,15 @@ private:
 
         Dyninst::InstructionAPI::InstructionDecoder dec;
 
+        /*
+         * Optional read-only cache of pre-decoded instructions. The
+         * decoder is not advanced on cache hits; decSynced records
+         * whether it must be repositioned before the next real decode.
+         */
+        const decodeCache_t *decodeCache;
+        bool decSynced;
+        Dyninst::InstructionAPI::Instruction::Ptr decodeCurrent();
+
         /*
          * Decoded instruction cache: contains the linear
          * sequence of instructions decoded by the decoder
@@ -41,6 +41,7 @@
 #include "CFG.h"
 #include "ParserDetails.h"
 #include "debug_parse.h"
+#include "common/src/dthread.h"
 
 
 using namespace std;
@@ -160,6 +161,12 @@ class region_data {
     dyn_hash_map<Address, ParseFrame *> frame_map;
     dyn_hash_map<Address, ParseFrame::Status> frame_status;
 
+    // Instructions decoded ahead of time by parallel parsing. Filled by
+    // the decode workers under decode_cache_lock, then read without
+    // locking while frames are parsed serially.
+    InsnAdapter::IA_IAPI::decodeCache_t decode_cache;
+    Mutex<false> decode_cache_lock;
+
     Function * findFunc(Address entry);
     Block * findBlock(Address entry);
     int findFuncs(Address addr, set<Function *> & funcs);
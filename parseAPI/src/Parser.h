@@ -97,6 +97,9 @@ class Parser {
     // a sink block for unbound edges
     Block * _sink;
 
+    // threads used to decode hinted functions ahead of parsing
+    unsigned _parse_threads;
+
     enum ParseState {
         UNPARSED,       // raw state
         PARTIAL,        // parsing has started
@@ -133,6 +136,13 @@ class Parser {
     void parse_at(Address addr, bool recursive, FuncSource src);
     void parse_edges(vector< ParseWorkElem * > & work_elems);
 
+    // persistent CFG cache (Parser-cache.C)
+    std::string cache_key();
+    bool save_cache(const std::string & file);
+    bool load_cache(const std::string & file);
+
+    void set_parse_threads(unsigned n) { _parse_threads = n ? n : 1; }
+
     CFGFactory & factory() const { return _cfgfact; }
     CodeObject & obj() { return _obj; }
 
@@ -152,6 +162,11 @@ class Parser {
 
  private:
     void parse_vanilla();
+
+    /* parallel pre-decoding of hinted functions */
+    typedef std::pair<Function *, region_data *> predecode_item;
+    void predecode(vector<ParseFrame *> & work);
+    static void predecode_func(predecode_item & item);
     void parse_gap_heuristic(CodeRegion *cr);
     void probabilistic_gap_parsing(CodeRegion* cr);
     //void parse_sbp();
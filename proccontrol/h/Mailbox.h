@@ -49,6 +49,7 @@ public:
 
    virtual void enqueue(Event::ptr ev, bool priority = false) = 0;
    virtual void enqueue_user(Event::ptr ev) = 0;
+   virtual void enqueue_batch(const std::vector<Event::ptr> &evs);
    virtual bool hasPriorityEvent() = 0;
    virtual Event::ptr dequeue(bool block) = 0;
    virtual Event::ptr peek() = 0;
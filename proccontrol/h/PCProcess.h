@@ -100,6 +100,53 @@ class MemoryUsage;
 
 class ExecFileInfo;
 
+/**
+ * A condition that an in-process breakpoint evaluates inside the target.
+ * Every test must hold for the breakpoint to trap.  A register test
+ * compares a general purpose register; a memory test loads size bytes
+ * (1, 2, 4 or 8) from base + offset, or from offset alone when base is
+ * InvalidReg.  Values narrower than 8 bytes are zero- or sign-extended
+ * before comparison.
+ **/
+class PC_EXPORT BreakpointCondition
+{
+ public:
+   typedef enum {
+      cmp_eq,
+      cmp_ne,
+      cmp_lt,
+      cmp_le,
+      cmp_gt,
+      cmp_ge
+   } cmp_t;
+
+   struct test_t {
+      Dyninst::MachRegister reg;
+      bool deref;
+      long offset;
+      unsigned size;
+      cmp_t cmp;
+      unsigned long value;
+      bool is_signed;
+   };
+
+   BreakpointCondition();
+
+   void addRegisterTest(Dyninst::MachRegister reg, cmp_t cmp, unsigned long value,
+                        bool is_signed = false);
+   void addMemoryTest(Dyninst::MachRegister base, long offset, unsigned size,
+                      cmp_t cmp, unsigned long value, bool is_signed = false);
+
+   //The first n hits on which the condition holds are only counted
+   void setIgnoreCount(unsigned long n);
+   unsigned long getIgnoreCount() const;
+
+   const std::vector<test_t> &getTests() const;
+ private:
+   std::vector<test_t> tests;
+   unsigned long ignore_count;
+};
+
 class PC_EXPORT Breakpoint 
 {
    friend class ::int_breakpoint;
@@ -124,6 +171,20 @@ class PC_EXPORT Breakpoint
    static Breakpoint::ptr newTransferOffsetBreakpoint(signed long shift);
    static Breakpoint::ptr newHardwareBreakpoint(unsigned int mode, unsigned int size);
 
+   //A conditional breakpoint that is checked by code injected into the
+   // target, so hits where the condition fails cost no trap.  The first
+   // displaced_bytes bytes at the breakpoint address are overwritten with
+   // a jump and run from the trampoline instead.  They must cover whole
+   // instructions with no PC-relative operands, and must be at least 5
+   // bytes on x86_64, the only supported platform.  No thread may be
+   // stopped part-way through them when the breakpoint is inserted.
+   //
+   //When the condition holds, the thread traps inside the trampoline and
+   // the EventBreakpoint reports the trampoline's address.
+   static Breakpoint::ptr newInProcessBreakpoint(const BreakpointCondition &cond,
+                                                 unsigned displaced_bytes);
+   bool isInProcess() const;
+
    void *getData() const;
    void setData(void *p) const;
 
@@ -495,6 +556,10 @@ class PC_EXPORT Process : public boost::enable_shared_from_this<Process>
    bool addBreakpoint(Dyninst::Address addr, Breakpoint::ptr bp) const;
    bool rmBreakpoint(Dyninst::Address addr, Breakpoint::ptr bp) const;
    unsigned numHardwareBreakpointsAvail(unsigned mode);
+   //Counters kept in the target by an in-process breakpoint: times the
+   // site ran, and times its condition held.
+   bool getBreakpointHitCounts(Dyninst::Address addr, Breakpoint::const_ptr bp,
+                               unsigned long &hits, unsigned long &matches) const;
 
    /**
     * Post IRPC.  Use continueProc/continueThread to run it,
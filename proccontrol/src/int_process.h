@@ -104,6 +104,22 @@ struct bp_install_state {
    result_response::ptr res_resp;
 };
 
+/**
+ * An in-process breakpoint at one address.  The first bytes at site are
+ * replaced by a jump to tramp, where the condition is evaluated.  The
+ * trampoline keeps three 8-byte words at counters: hits, matches and the
+ * ignore count.  When the condition holds it reaches trap, which carries
+ * an ordinary software breakpoint.
+ **/
+struct inproc_bp_site {
+   Dyninst::Address site;
+   Dyninst::Address tramp;
+   unsigned long tramp_size;
+   Dyninst::Address counters;
+   Dyninst::Address trap;
+   std::vector<unsigned char> orig_bytes;
+};
+
 /**
  * Data reflecting the contents of a process's memory should be
  * stored in the mem_state object (e.g, breakpoints, libraries
@@ -392,6 +408,19 @@ class int_process
 
    sw_breakpoint *getBreakpoint(Dyninst::Address addr);
 
+   bool addInProcessBreakpoint(Dyninst::Address addr, int_breakpoint *bp);
+   bool removeInProcessBreakpoint(Dyninst::Address addr, int_breakpoint *bp, std::set<response::ptr> &resps);
+   inproc_bp_site *getInProcessBreakpoint(Dyninst::Address addr, int_breakpoint *bp);
+   virtual bool plat_supportsInProcessBreakpoints();
+   //Fills in tramp with the trampoline for site (at site->tramp) and jump
+   // with the bytes that replace site->orig_bytes.  Sets site->trap.
+   virtual bool plat_createInProcessTrampoline(inproc_bp_site *site, const BreakpointCondition &cond,
+                                               std::vector<unsigned char> &tramp,
+                                               std::vector<unsigned char> &jump);
+   //Unmapped, page-aligned space for size bytes within range of addr, or 0
+   virtual Dyninst::Address plat_findFreeMemoryNear(Dyninst::Address addr, unsigned long size,
+                                                    unsigned long range);
+
    virtual unsigned plat_breakpointSize() = 0;
    virtual void plat_breakpointBytes(unsigned char *buffer) = 0;
    virtual bool plat_breakpointAdvancesPC() const = 0;
@@ -432,6 +461,18 @@ class int_process
    virtual bool plat_writeMem(int_thread *thr, const void *local,
                               Dyninst::Address remote, size_t size, bp_write_t bp_write) = 0;
 
+   //Reads several ranges with a single platform operation.  Returns the
+   // number of leading ranges that were read completely; the rest should
+   // be read individually with readMem.  Platforms without vectored
+   // access read nothing and return 0.
+   struct mem_range_t {
+      Dyninst::Address remote;
+      void *local;
+      size_t size;
+   };
+   size_t readMemVector(std::vector<mem_range_t> &ranges);
+   virtual size_t plat_readMemVector(int_thread *thr, const std::vector<mem_range_t> &ranges);
+
    virtual async_ret_t plat_calcTLSAddress(int_thread *thread, int_library *lib, Offset off,
                                            Address &outaddr, std::set<response::ptr> &resps);
 
@@ -570,6 +611,7 @@ class int_process
    static bool in_callback;
    mem_state::ptr mem;
    std::map<Dyninst::Address, unsigned> exec_mem_cache;
+   std::map<std::pair<Dyninst::Address, int_breakpoint *>, inproc_bp_site *> inproc_bps;
    int continueSig;
    bool createdViaAttach;
    memCache mem_cache;
@@ -1305,11 +1347,14 @@ class int_breakpoint
    bool procstopper;
    bool suppress_callbacks;
    bool offset_transfer;
+   BreakpointCondition *inproc_cond;
+   unsigned inproc_displaced;
    std::set<Thread::const_ptr> thread_specific;
  public:
    int_breakpoint(Breakpoint::ptr up);
    int_breakpoint(Dyninst::Address to, Breakpoint::ptr up, bool off);
    int_breakpoint(unsigned int hw_prems_, unsigned int hw_size_, Breakpoint::ptr up);
+   int_breakpoint(const BreakpointCondition &cond, unsigned displaced, Breakpoint::ptr up);
    ~int_breakpoint();
 
    bool isCtrlTransfer() const;
@@ -1338,6 +1383,10 @@ class int_breakpoint
 
    bool isOffsetTransfer() const;
    Breakpoint::weak_ptr upBreakpoint() const;
+
+   bool isInProcess() const;
+   const BreakpointCondition *getCondition() const;
+   unsigned getDisplacedBytes() const;
 };
 
 class bp_instance
@@ -60,6 +60,10 @@ class GeneratorLinux : public GeneratorMT
    int generator_lwp;
    int generator_pid;
 
+   //Upper bound on statuses collected per getMultiEvent call
+   static const unsigned MaxWaitBatch = 256;
+   void printWaitStatus(int pid, int status);
+
   public:
    GeneratorLinux();
    virtual ~GeneratorLinux();
@@ -67,6 +71,7 @@ class GeneratorLinux : public GeneratorMT
    virtual bool initialize();
    virtual bool canFastHandle();
    virtual ArchEvent *getEvent(bool block);
+   virtual bool getMultiEvent(bool block, std::vector<ArchEvent *> &events);
    void evictFromWaitpid();
 };
 
@@ -132,6 +137,7 @@ class linux_process : public sysv_process, public unix_process, public thread_db
                              Dyninst::Address remote, size_t size);
    virtual bool plat_writeMem(int_thread *thr, const void *local,
                               Dyninst::Address remote, size_t size, bp_write_t bp_write);
+   virtual size_t plat_readMemVector(int_thread *thr, const std::vector<mem_range_t> &ranges);
    virtual SymbolReaderFactory *plat_defaultSymReader();
    virtual bool needIndividualThreadAttach();
    virtual bool getThreadLWPs(std::vector<Dyninst::LWP> &lwps);
@@ -157,6 +163,16 @@ class linux_process : public sysv_process, public unix_process, public thread_db
 
   protected:
    int computeAddrWidth();
+
+  private:
+   //Direct access to the process' memory through process_vm_readv/writev
+   // and /proc/<pid>/mem, used ahead of the word-at-a-time ptrace path.
+   bool readMemDirect(void *local, Dyninst::Address remote, size_t size);
+   bool writeMemDirect(const void *local, Dyninst::Address remote, size_t size);
+   int getMemFD();
+   void closeMemFD();
+   int mem_fd;
+   bool mem_fd_failed;
 };
 
 class linux_x86_process : public linux_process, public x86_process
@@ -64,6 +64,8 @@ class unix_process : virtual public int_process
                                                Process::MemoryRegion& memRegion);
 
    virtual Dyninst::Address plat_mallocExecMemory(Dyninst::Address, unsigned size);
+   virtual Dyninst::Address plat_findFreeMemoryNear(Dyninst::Address addr, unsigned long size,
+                                                    unsigned long range);
 
    virtual bool plat_supportFork();
    virtual bool plat_supportExec();
@@ -47,6 +47,10 @@ class x86_process : virtual public int_process
   virtual void plat_breakpointBytes(unsigned char *buffer);
   virtual bool plat_breakpointAdvancesPC() const;
   virtual Address plat_findFreeMemory(size_t) { return 0; }
+  virtual bool plat_supportsInProcessBreakpoints();
+  virtual bool plat_createInProcessTrampoline(inproc_bp_site *site, const BreakpointCondition &cond,
+                                              std::vector<unsigned char> &tramp,
+                                              std::vector<unsigned char> &jump);
 };
 
 class x86_thread : virtual public int_thread
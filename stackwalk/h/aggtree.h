@@ -0,0 +1,127 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef AGGTREE_H_
+#define AGGTREE_H_
+
+#include "basetypes.h"
+#include <string>
+#include <vector>
+
+namespace Dyninst {
+namespace Stackwalker {
+
+class Frame;
+
+/**
+ * AggregateCallTree merges call stacks from many threads into a single
+ * prefix tree, for when CallTree's per-child std::set comparisons dominate
+ * the cost of a large-scale walk.
+ *
+ * Frames are reduced to a (library, offset) pair and nodes are hash-consed
+ * on (parent, library, offset), so adding a stack is one hash probe per
+ * frame.  Each node keeps a count of the stacks that pass through it,
+ * its children in an array sorted by (library, offset), and a bitmap of
+ * the threads whose stacks pass through it.
+ *
+ * Trees built independently, on other threads or in other daemons, can be
+ * combined with merge() and shipped with serialize()/deserialize().
+ **/
+class SW_EXPORT AggregateCallTree {
+  public:
+   typedef unsigned node_id;
+   static const node_id root = 0;
+
+   AggregateCallTree();
+   ~AggregateCallTree();
+
+   // Interns a library name; ids are local to this tree
+   unsigned libId(const std::string &lib);
+   // Finds or creates the child of parent at lib+offset and adds
+   // count to it.
+   node_id addChild(node_id parent, unsigned lib, Dyninst::Offset offset,
+                    unsigned long count = 1);
+   // Marks thrd as passing through node
+   void addThread(node_id node, THR_ID thrd);
+
+   // stk is innermost-first, as returned by Walker::walkStack.  Frames
+   // without a library are keyed by their absolute RA under an empty
+   // library name.
+   node_id addCallStack(const std::vector<Frame> &stk, THR_ID thrd);
+   // Stack given as lib/offset pairs, outermost-first
+   node_id addCallStack(const std::vector<std::pair<unsigned, Dyninst::Offset> > &stk,
+                        THR_ID thrd);
+
+   void merge(const AggregateCallTree &other);
+
+   // Compact, platform-independent encoding of the whole tree
+   void serialize(std::vector<unsigned char> &out) const;
+   bool deserialize(const unsigned char *buffer, size_t size);
+   void clear();
+
+   unsigned numNodes() const { return (unsigned) nodes.size(); }
+   unsigned numThreads() const { return (unsigned) threads.size(); }
+   const std::string &libName(unsigned lib) const { return libs[lib]; }
+
+   node_id getParent(node_id n) const { return nodes[n].parent; }
+   unsigned getLib(node_id n) const { return nodes[n].lib; }
+   Dyninst::Offset getOffset(node_id n) const { return nodes[n].offset; }
+   unsigned long getCount(node_id n) const { return nodes[n].count; }
+   const std::vector<node_id> &getChildren(node_id n) const { return nodes[n].children; }
+   void getThreads(node_id n, std::vector<THR_ID> &out) const;
+   bool hasThread(node_id n, THR_ID thrd) const;
+
+  private:
+   struct agg_node {
+      node_id parent;
+      unsigned lib;
+      Dyninst::Offset offset;
+      unsigned long count;
+      std::vector<node_id> children;
+      std::vector<unsigned long long> thread_bits;
+   };
+   class int_index;
+
+   std::vector<agg_node> nodes;
+   std::vector<std::string> libs;
+   std::vector<THR_ID> threads;
+   int_index *index;
+
+   unsigned threadIndex(THR_ID thrd);
+   void setThreadBit(node_id n, unsigned bit);
+
+   AggregateCallTree(const AggregateCallTree &);
+   AggregateCallTree &operator=(const AggregateCallTree &);
+};
+
+}
+}
+
+#endif
@@ -50,6 +50,7 @@ namespace Stackwalker {
 class LibraryState;
 class ThreadState;
 class Walker;
+class int_walkerSet;
 
 class SW_EXPORT ProcessState {
    friend class Walker;
@@ -101,6 +102,11 @@ public:
   virtual bool preStackwalk(Dyninst::THR_ID tid);
   virtual bool postStackwalk(Dyninst::THR_ID tid);
 
+  //Bracket a walk of every thread in the process, so per-walk setup
+  // such as stopping the process is done once rather than per thread.
+  virtual bool preBatchStackwalk();
+  virtual bool postBatchStackwalk();
+
   virtual bool isFirstParty() = 0;
 
   std::string getExecutablePath();
@@ -122,11 +128,23 @@ class ProcSelf : public ProcessState {
 };
 
 class SW_EXPORT ProcDebug : public ProcessState {
+   friend class int_walkerSet;
  protected:
    Dyninst::ProcControlAPI::Process::ptr proc;
    ProcDebug(Dyninst::ProcControlAPI::Process::ptr p);
 
    std::set<Dyninst::ProcControlAPI::Thread::ptr> needs_resume;
+
+   //While a batched walk holds every thread stopped, memory reads are
+   // served from whole blocks kept here, keyed by block address.
+   static const unsigned mem_block_size = 4096;
+   std::map<Dyninst::Address, std::vector<unsigned char> > mem_cache;
+   bool mem_cache_active;
+   bool batch_stopped;
+
+   bool readMemCached(void *dest, Dyninst::Address source, size_t size);
+   static bool beginBatch(const std::vector<ProcDebug *> &pds);
+   static bool endBatch(const std::vector<ProcDebug *> &pds);
  public:
   
   static ProcDebug *newProcDebug(Dyninst::PID pid, std::string executable="");
@@ -145,6 +163,8 @@ class SW_EXPORT ProcDebug : public ProcessState {
 
   virtual bool preStackwalk(Dyninst::THR_ID tid);
   virtual bool postStackwalk(Dyninst::THR_ID tid);
+  virtual bool preBatchStackwalk();
+  virtual bool postBatchStackwalk();
 
   
   virtual bool pause(Dyninst::THR_ID tid = NULL_THR_ID);
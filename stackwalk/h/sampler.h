@@ -0,0 +1,108 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SAMPLER_H_
+#define SAMPLER_H_
+
+#include "basetypes.h"
+#include <vector>
+#include <string>
+
+namespace Dyninst {
+namespace Stackwalker {
+
+class Walker;
+class int_sampler;
+
+// One symbolized sample: the interrupted PC followed by the return
+// addresses of its callers, innermost first. names[i] is empty where
+// the SymbolLookup had no answer.
+struct SW_EXPORT Sample {
+   Dyninst::THR_ID thread;
+   std::vector<Dyninst::Address> pcs;
+   std::vector<std::string> names;
+};
+
+typedef void (*sample_handler_t)(std::vector<Sample> &samples, void *arg);
+
+/**
+ * First-party sampling profiler built on a ProcSelf Walker.
+ *
+ * Each profiled thread calls registerThread(), which preallocates that
+ * thread's ring of raw samples. On SIGPROF the handler walks the
+ * interrupted thread's frame-pointer chain straight into its ring; it
+ * does not allocate, lock or look up symbols. A background thread drains
+ * the rings every flush_ms and symbolizes the samples in batches through
+ * the Walker's SymbolLookup, which it then owns until stop().
+ *
+ * Only frame pointers are followed, so code built without them gives
+ * truncated chains. One Sampler may run at a time.
+ **/
+class SW_EXPORT Sampler {
+ private:
+   int_sampler *isampler;
+   Sampler(int_sampler *s);
+ public:
+   static Sampler *newSampler(Walker *walker,
+                              unsigned max_depth = 64,
+                              unsigned ring_samples = 1024);
+   ~Sampler();
+
+   // Called on the thread to be profiled.  The thread must unregister
+   // before it exits.
+   bool registerThread();
+   void unregisterThread();
+
+   // Arm ITIMER_PROF for hz samples per second of process CPU time and
+   // start delivering batches to handler on the background thread.
+   bool start(unsigned hz, sample_handler_t handler, void *arg,
+              unsigned flush_ms = 100);
+   // Disarm the timer and deliver whatever is still buffered.
+   void stop();
+
+   // Drain and symbolize buffered samples on the calling thread.
+   // Only for use while the sampler is stopped.
+   unsigned flush(std::vector<Sample> &out);
+
+   // Samples lost to full rings or to threads that never registered
+   unsigned long dropped() const;
+
+   // The signal-safe walk itself, for callers with their own handler.
+   // Frame pointers are trusted only inside [stack_lo, stack_hi).
+   static unsigned walkContext(void *ucontext,
+                               Dyninst::Address *pcs, unsigned max_depth,
+                               Dyninst::Address stack_lo,
+                               Dyninst::Address stack_hi);
+};
+
+}
+}
+
+#endif
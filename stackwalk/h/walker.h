@@ -131,6 +131,11 @@ class SW_EXPORT Walker {
    bool walkStack(std::vector<Frame> &stackwalk, 
                   Dyninst::THR_ID thread = NULL_THR_ID);
 
+   //Collect a stackwalk of every thread in the process.  The process is
+   // stopped once for all of them, and stackwalks[i] belongs to threads[i].
+   bool walkStacks(std::vector<std::vector<Frame> > &stackwalks,
+                   std::vector<Dyninst::THR_ID> &threads);
+
    //Collect a stackwalk starting at a certain frame
    bool walkStackFromFrame(std::vector<Frame> &stackwalk, 
                            const Frame &frame);
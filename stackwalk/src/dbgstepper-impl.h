@@ -33,6 +33,7 @@
 
 #include "stackwalk/h/framestepper.h"
 #include "common/h/ProcReader.h"
+#include "stackwalk/src/lib-offset-cache.h"
 
 namespace Dyninst {
 
@@ -56,9 +57,13 @@ class DebugStepperImpl : public FrameStepper, public Dyninst::ProcessReader {
     };
 
     dyn_hash_map<Address, cache_t> cache_;
+    // Third-party walks share results across processes
+    static LibOffsetCache<cache_t> shared_cache_;
 
     void addToCache(const Frame &cur, const Frame &caller);
     bool lookupInCache(const Frame &cur, Frame &caller);
+    void storeCacheEntry(const Frame &cur, const cache_t &entry);
+    bool findCacheEntry(const Frame &cur, cache_t &entry);
 
    Dyninst::Address last_addr_read;
    unsigned long last_val_read;
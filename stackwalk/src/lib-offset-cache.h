@@ -0,0 +1,194 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef LIB_OFFSET_CACHE_H_
+#define LIB_OFFSET_CACHE_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <sys/stat.h>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+#include "common/h/dyntypes.h"
+
+namespace Dyninst {
+namespace Stackwalker {
+
+/**
+ * Every LibOffsetCache registers here so that a library load can drop
+ * entries made for an older file at the same path.
+ **/
+class LibOffsetCacheBase
+{
+ protected:
+   // Which file a library's entries were made for
+   struct file_id {
+      unsigned long long dev, ino, size, mtime;
+      bool operator==(const file_id &o) const {
+         return dev == o.dev && ino == o.ino && size == o.size && mtime == o.mtime;
+      }
+   };
+
+   static bool getFileId(const std::string &lib, file_id &id)
+   {
+      struct stat st;
+      if (stat(lib.c_str(), &st) != 0)
+         return false;
+      id.dev = st.st_dev;
+      id.ino = st.st_ino;
+      id.size = st.st_size;
+      id.mtime = st.st_mtime;
+      return true;
+   }
+
+   static boost::mutex &registryLock()
+   {
+      static boost::mutex m;
+      return m;
+   }
+
+   static std::set<LibOffsetCacheBase *> &registry()
+   {
+      static std::set<LibOffsetCacheBase *> caches;
+      return caches;
+   }
+
+   LibOffsetCacheBase()
+   {
+      boost::lock_guard<boost::mutex> g(registryLock());
+      registry().insert(this);
+   }
+
+   virtual ~LibOffsetCacheBase()
+   {
+      boost::lock_guard<boost::mutex> g(registryLock());
+      registry().erase(this);
+   }
+
+   virtual void checkLibrary(const std::string &lib) = 0;
+
+ public:
+   // Called by StepperGroup whenever a library is loaded into a walked
+   // process
+   static void libraryLoaded(const std::string &lib)
+   {
+      boost::lock_guard<boost::mutex> g(registryLock());
+      std::set<LibOffsetCacheBase *>::iterator i = registry().begin();
+      for (; i != registry().end(); i++)
+         (*i)->checkLibrary(lib);
+   }
+};
+
+/**
+ * A cache of per-instruction unwind results shared by every Walker in the
+ * tool.  Entries are keyed by library path and offset rather than by
+ * address, so work done for one process is reused by every other process
+ * that maps the same library, wherever it was loaded.
+ *
+ * A library's entries are dropped when a load shows that the file at its
+ * path has changed, and the whole cache is emptied once it holds
+ * max_entries results.
+ **/
+template <class V>
+class LibOffsetCache : public LibOffsetCacheBase
+{
+ private:
+   static const size_t max_entries = 1 << 20;
+
+   struct lib_entries {
+      file_id id;
+      bool has_id;
+      std::map<Offset, V> offsets;
+   };
+   std::map<std::string, lib_entries> libs;
+   size_t num_entries;
+   boost::mutex lock;
+
+   virtual void checkLibrary(const std::string &lib)
+   {
+      file_id id;
+      bool has_id = getFileId(lib, id);
+      boost::lock_guard<boost::mutex> g(lock);
+      typename std::map<std::string, lib_entries>::iterator i = libs.find(lib);
+      if (i == libs.end())
+         return;
+      if (has_id && i->second.has_id && id == i->second.id)
+         return;
+      num_entries -= i->second.offsets.size();
+      libs.erase(i);
+   }
+
+ public:
+   LibOffsetCache() :
+      num_entries(0)
+   {
+   }
+
+   bool lookup(const std::string &lib, Offset off, V &result)
+   {
+      boost::lock_guard<boost::mutex> g(lock);
+      typename std::map<std::string, lib_entries>::iterator i = libs.find(lib);
+      if (i == libs.end())
+         return false;
+      typename std::map<Offset, V>::iterator j = i->second.offsets.find(off);
+      if (j == i->second.offsets.end())
+         return false;
+      result = j->second;
+      return true;
+   }
+
+   void insert(const std::string &lib, Offset off, const V &val)
+   {
+      boost::lock_guard<boost::mutex> g(lock);
+      if (num_entries >= max_entries) {
+         libs.clear();
+         num_entries = 0;
+      }
+      typename std::map<std::string, lib_entries>::iterator i = libs.find(lib);
+      if (i == libs.end()) {
+         i = libs.insert(std::make_pair(lib, lib_entries())).first;
+         i->second.has_id = getFileId(lib, i->second.id);
+      }
+      std::pair<typename std::map<Offset, V>::iterator, bool> r =
+         i->second.offsets.insert(std::make_pair(off, val));
+      if (r.second)
+         num_entries++;
+      else
+         r.first->second = val;
+   }
+};
+
+}
+}
+
+#endif
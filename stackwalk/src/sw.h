@@ -164,6 +164,8 @@ private:
    void clearProcSet();
    void initProcSet();
    bool walkStacksProcSet(CallTree &tree, bool &bad_plat, bool walk_iniital_only);
+   bool preBatchWalk();
+   bool postBatchWalk();
 
    unsigned non_pd_walkers;
    set<Walker *> walkers;
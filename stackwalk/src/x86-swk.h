@@ -36,6 +36,7 @@
 #include "common/h/dyntypes.h"
 
 #include "common/src/lru_cache.h"
+#include "stackwalk/src/lib-offset-cache.h"
 
 namespace Dyninst {
 namespace Stackwalker {
@@ -67,10 +68,11 @@ private:
 
    void updateCache(Address addr, alloc_frame_t result);
    bool checkCache(Address addr, alloc_frame_t &result);
-   //We need some kind of re-entrant safe synhronization before we can
-   // globally turn this caching on, but it would sure help things.
    static const unsigned int cache_size = 64;
    LRUCache<Address, alloc_frame_t> cache;
+   //First-party walks use the LRU cache above, which takes no locks.
+   // Third-party walks share results across processes.
+   static LibOffsetCache<FrameFuncHelper::alloc_frame_t> shared_cache;
 public:
    static LookupFuncStart *getLookupFuncStart(ProcessState *p);
    void releaseMe();
@@ -45,6 +45,7 @@
 #include "Annotatable.h"
 #include "Serialization.h"
 #include <boost/shared_ptr.hpp>
+#include <atomic>
 
 #ifndef CASE_RETURN_STR
 #define CASE_RETURN_STR(x) case x: return #x
@@ -283,6 +284,40 @@ class SYMTAB_EXPORT Symbol : public Serializable,
 
    bool versionHidden_;
 
+   // Pretty and typed names are demangled on first use and kept here.
+   // Each is published with one atomic store, so concurrent readers see
+   // either no name or a complete one.  Copies start empty.
+   class DemangleCache {
+    public:
+      DemangleCache() : pretty_(NULL), typed_(NULL) {}
+      DemangleCache(const DemangleCache &) : pretty_(NULL), typed_(NULL) {}
+      DemangleCache &operator=(const DemangleCache &) { clear(); return *this; }
+      ~DemangleCache() { clear(); }
+
+      const std::string *pretty() const { return pretty_.load(std::memory_order_acquire); }
+      const std::string *typed() const { return typed_.load(std::memory_order_acquire); }
+      const std::string *setPretty(std::string *n) const { return publish(pretty_, n); }
+      const std::string *setTyped(std::string *n) const { return publish(typed_, n); }
+      void clear()
+      {
+         delete pretty_.exchange(NULL);
+         delete typed_.exchange(NULL);
+      }
+
+    private:
+      static const std::string *publish(std::atomic<std::string *> &slot, std::string *n)
+      {
+         std::string *expected = NULL;
+         if (slot.compare_exchange_strong(expected, n, std::memory_order_acq_rel))
+            return n;
+         delete n;
+         return expected;
+      }
+      mutable std::atomic<std::string *> pretty_;
+      mutable std::atomic<std::string *> typed_;
+   };
+   DemangleCache demangled_;
+
    void restore_module_and_region(SerializerBase *, 
 		   std::string &, Offset) THROW_SPEC (SerializerError);
 
@@ -0,0 +1,94 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef __SYMBOLCACHE_H__
+#define __SYMBOLCACHE_H__
+
+#include "symutil.h"
+#include "Symbol.h"
+#include <string>
+#include <vector>
+
+class MappedFile;
+
+namespace Dyninst {
+namespace SymtabAPI {
+
+class Symtab;
+
+/**
+ * An on-disk symbol table laid out so it can be used straight from an
+ * mmap: a string table, an array of fixed-size symbol records, and sorted
+ * index arrays, all addressed by file offset.  Caches are keyed by the
+ * SHA1 of the binary, so one cache directory can be shared between runs
+ * and between tools.  Symbol objects are only built for the records a
+ * lookup actually returns, and are owned by the cache.
+ **/
+class SYMTAB_EXPORT SymbolCache {
+ public:
+   //  Writes a cache for obj's symbols into dir (by default
+   //  $HOME/.dyninstAPI/caches/symbols).  Replaces any existing cache
+   //  for the same file contents atomically.
+   static bool build(Symtab *obj, std::string dir = std::string());
+
+   //  Maps the cache for filename's current contents, or returns NULL if
+   //  there is none (or it is stale or damaged).
+   static SymbolCache *open(std::string filename, std::string dir = std::string());
+
+   ~SymbolCache();
+
+   std::string checksum() const;
+   unsigned numSymbols() const;
+
+   bool findSymbol(std::vector<Symbol *> &ret,
+                   const std::string &name,
+                   Symbol::SymbolType sType = Symbol::ST_UNKNOWN,
+                   NameType nameType = anyName);
+   bool findSymbolsByOffset(std::vector<Symbol *> &ret, Offset offset);
+   bool getAllSymbols(std::vector<Symbol *> &ret);
+
+ private:
+   SymbolCache(MappedFile *mf);
+   SymbolCache(const SymbolCache &);
+   SymbolCache &operator=(const SymbolCache &);
+
+   Symbol *materialize(unsigned i);
+   void lookupName(std::vector<unsigned> &hits, const std::string &name,
+                   unsigned index) const;
+
+   MappedFile *mf_;
+   const char *base_;
+   std::vector<Symbol *> syms_;
+};
+
+}
+}
+
+#endif
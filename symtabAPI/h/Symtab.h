@@ -41,6 +41,7 @@
 #include "Serialization.h"
 #include "ProcReader.h"
 #include "IBSTree.h"
+#include "FlatIntervalIndex.h"
 
 #include "version.h"
 
@@ -212,6 +213,9 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    bool findRegion(Region *&ret, std::string regname);
    bool findRegion(Region *&ret, const Offset addr, const unsigned long size);
    bool findRegionByEntry(Region *&ret, const Offset offset);
+   // Returns the region whose memory range contains offset.  Where
+   // regions overlap (unloaded sections at address 0), the innermost,
+   // i.e. shortest, containing region is returned.
    Region *findEnclosingRegion(const Offset offset);
 
    // Exceptions
@@ -280,6 +284,12 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
 
    void parseTypesNow();
 
+   // When enabled, type and local variable information is parsed one
+   // compilation unit at a time as functions and modules ask for it,
+   // rather than for the whole object on first use.
+   void setLazyTypeParsing(bool value);
+   bool getLazyTypeParsing();
+
    /***** Local Variable Information *****/
    bool findLocalVariable(std::vector<localVar *>&vars, std::string name);
 
@@ -301,6 +311,18 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    bool addRegion(Region *newreg);
    bool emit(std::string filename, unsigned flag = 0);
 
+   // Dynamic symbol hash tables written by emit(). GNU and Both reorder
+   // the defined dynamic symbols by hash bucket, as .gnu.hash requires.
+   // HashStyleDefault writes only .hash and keeps the .dynsym order, even
+   // if the input binary had a .gnu.hash.
+   typedef enum {
+      HashStyleDefault,
+      HashStyleSysV,
+      HashStyleGNU,
+      HashStyleBoth} hash_style_t;
+   void setHashStyle(hash_style_t style);
+   hash_style_t getHashStyle() const;
+
    void addDynLibSubstitution(std::string oldName, std::string newName);
    std::string getDynLibSubstitution(std::string name);
 
@@ -427,6 +449,7 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    bool deleteAggregate(Aggregate *agg);
 
    bool addFunctionRange(FunctionBase *fbase, Dyninst::Offset next_start);
+   void invalidateRegionLookup();
 
    // Used by binaryEdit.C...
  public:
@@ -436,6 +459,8 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    Module *getOrCreateModule(const std::string &modName, 
                                            const Offset modAddr);
    bool parseFunctionRanges();
+   void parseTypesAt(Offset addr);
+   void parseTypesForModule(Module *mod);
 
    //Only valid on ELF formats
    Offset getElfDynamicOffset();
@@ -460,6 +485,8 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    void parseLineInformation();
    
    void parseTypes();
+   bool parseTypesForName(std::string name);
+   void updateModuleTypes();
    bool setDefaultNamespacePrefix(std::string &str);
 
    bool addUserRegion(Region *newreg);
@@ -522,9 +549,7 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
 
    // Indices
    struct offset {};
-   struct pretty {};
    struct mangled {};
-   struct typed {};
    struct id {};
    
  
@@ -534,14 +559,22 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    boost::multi_index_container<Symbol::Ptr, indexed_by <
    ordered_unique< tag<id>, const_mem_fun < Symbol::Ptr, Symbol*, &Symbol::Ptr::get> >,
    ordered_non_unique< tag<offset>, const_mem_fun < Symbol, Offset, &Symbol::getOffset > >,
-   hashed_non_unique< tag<mangled>, const_mem_fun < Symbol, std::string, &Symbol::getMangledName > >,
-   hashed_non_unique< tag<pretty>, const_mem_fun < Symbol, std::string, &Symbol::getPrettyName > >,
-   hashed_non_unique< tag<typed>, const_mem_fun < Symbol, std::string, &Symbol::getTypedName > >
+   hashed_non_unique< tag<mangled>, const_mem_fun < Symbol, std::string, &Symbol::getMangledName > >
    >
    > indexed_symbols;
    
    indexed_symbols everyDefinedSymbol;
    indexed_symbols undefDynSyms;
+
+   // Pretty and typed names need a demangle per symbol, so their indices
+   // are built by the first lookup that asks for them rather than on every
+   // insert, and are dropped whenever the symbol set changes.
+   typedef dyn_hash_map<std::string, std::vector<Symbol *> > demangled_index;
+   struct demangled_indices {
+      demangled_index pretty, typed, undefPretty, undefTyped;
+   };
+   const demangled_indices &getDemangledIndices();
+   void invalidateDemangledIndices();
    
    // We also need per-Aggregate indices
    bool sorted_everyFunction;
@@ -572,6 +605,8 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
 
    //type info valid flag
    bool isTypeInfoValid_;
+   bool lazyTypes_;
+   hash_style_t hashStyle_;
 
    int nlines_;
    unsigned long fdptr_;
@@ -592,7 +627,10 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    bool isStaticBinary_;
    bool isDefensiveBinary_;
 
-   FuncRangeLookup *func_lookup;
+   FlatIntervalIndex<FuncRange *> *func_lookup;
+   // Built on first lookup under a lock, so concurrent readers never see
+   // it half-built
+   std::atomic<FlatIntervalIndex<Region *> *> region_lookup;
 
    //Don't use obj_private, use getObject() instead.
  public:
@@ -609,6 +647,7 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
 
  private:
     unsigned _ref_cnt;
+    std::atomic<demangled_indices *> demangledIndices_;
 };
 
 /**
@@ -258,6 +258,7 @@ class stab_entry_64 : public stab_entry {
 
 class pdElfShdr;
 class Symtab;
+class DwarfWalker;
 class Region;
 class Object;
 
@@ -282,6 +283,9 @@ class Object;
   void parseFileLineInfo(Symtab *obj);
   
   void parseTypeInfo(Symtab *obj);
+  virtual bool parseTypeInfoAt(Symtab *obj, Offset addr);
+  virtual bool parseTypeInfoForModule(Symtab *obj, Module *mod);
+  virtual bool parseTypeInfoForName(Symtab *obj, std::string name);
 
   bool needs_function_binding() const { return (plt_addr_ > 0); } 
   bool get_func_binding_table(std::vector<relocationEntry> &fbt) const;
@@ -474,6 +478,8 @@ class Object;
   public:
   Dyninst::Dwarf::DwarfHandle::ptr dwarf;
   private:
+  DwarfWalker *lazyTypeWalker_;
+  DwarfWalker *lazyTypeWalker(Symtab *obj);
 
   bool      EEL;                 // true if EEL rewritten
   bool 	    did_open;		// true if the file has been mmapped
@@ -555,6 +561,18 @@ class Object;
                      Elf_X_Shdr* symscnp,
                      bool shared_library,
                      std::string module);
+
+  // A contiguous run of .symtab entries, turned into Symbols by one
+  // worker; syms[k] is NULL where entry begin+k was discarded.
+  struct symbol_chunk {
+     unsigned begin, end;
+     std::vector<Symbol *> syms;
+  };
+  Symbol *parse_symbol(Elf_X_Sym &syms, unsigned i, const char *strs,
+                       Elf_X_Shdr *bssscnp, Elf_X_Shdr *symscnp);
+  void parse_symbol_chunk(Elf_X_Sym &syms, const char *strs,
+                          Elf_X_Shdr *bssscnp, Elf_X_Shdr *symscnp,
+                          symbol_chunk &chunk);
   
   void parse_dynamicSymbols( Elf_X_Shdr *& dyn_scnp, Elf_X_Data &symdata,
                              Elf_X_Data &strdata, bool shared_library,
@@ -58,6 +58,7 @@ namespace SymtabAPI{
 extern bool symbol_compare(const Symbol *s1, const Symbol *s2);
 
 class Symtab;
+class Module;
 class Region;
 class ExceptionBlock;
 class relocationEntry;
@@ -140,6 +141,12 @@ public:
     virtual bool getTruncateLinePaths();
     virtual Region::RegionType getRelType() const { return Region::RT_INVALID; }
 
+    // Lazy type parsing; these return false if the format can only
+    // parse all of its type information at once.
+    virtual bool parseTypeInfoAt(Symtab *, Offset) { return false; }
+    virtual bool parseTypeInfoForModule(Symtab *, Module *) { return false; }
+    virtual bool parseTypeInfoForName(Symtab *, std::string) { return false; }
+
     // Only implemented for ELF right now
     SYMTAB_EXPORT virtual void getSegmentsSymReader(std::vector<SymSegment> &) {};
 	SYMTAB_EXPORT virtual void rebase(Offset) {};
@@ -13,6 +13,7 @@
 #include "VariableLocation.h"
 #include "Type.h"
 #include "Object.h"
+#include "FlatIntervalIndex.h"
 #include <boost/shared_ptr.hpp>
 #include <Collections.h>
 
@@ -181,6 +182,17 @@ namespace Dyninst {
 
             // Takes current debug state as represented by dbg_;
             bool parseModule(Dwarf_Bool is_info, Module *&fixUnknownMod);
+            bool parseModuleDIE(Dwarf_Die moduleDIE, Module *&fixUnknownMod);
+
+            // Lazy parsing: buildCUIndex records every compilation unit
+            // along with the addresses (.debug_aranges or the CU's pc
+            // bounds) and names (.debug_pubnames, .debug_pubtypes) it
+            // covers.  The parseCUs* calls then parse only the matching
+            // units; parse() finishes whatever is left.
+            bool buildCUIndex();
+            bool parseCUsAt(Address addr);
+            bool parseCUsForModule(Module *m);
+            bool parseCUsForName(const std::string &name);
 
             // Non-recursive version of parse
             // A Context must be provided as an _input_ to this function,
@@ -346,6 +358,35 @@ namespace Dyninst {
             void findAllSig8Types();
             bool findSig8Type(Dwarf_Sig8 *signature, Type *&type);
 
+            bool findModuleName(Dwarf_Die moduleDIE, Dwarf_Half moduleTag,
+                                std::string &moduleName);
+            void fixUnknownTypes(Module *m);
+
+            // Lazy parsing state; see buildCUIndex.
+            struct CUInfo {
+                Dwarf_Bool is_info;
+                Dwarf_Off die_offset;
+                Dwarf_Off compile_offset;
+                Dwarf_Unsigned next_cu_header;
+                Dwarf_Unsigned cu_header_length;
+                Dwarf_Half version;
+                Dwarf_Unsigned abbrev_offset;
+                Dwarf_Half addr_size;
+                Dwarf_Half offset_size;
+                Dwarf_Half extension_size;
+                Dwarf_Sig8 signature;
+                Dwarf_Unsigned typeoffset;
+                Module *mod;
+                bool parsed;
+            };
+            bool indexed_;
+            bool typeUnitsParsed_;
+            std::vector<CUInfo> cus_;
+            FlatIntervalIndex<unsigned> cuRanges_;
+            std::vector<unsigned> unmappedCUs_;
+            dyn_hash_map<std::string, std::vector<unsigned> > cusByName_;
+            bool parseCU(unsigned i);
+
         protected:
             virtual void setFuncReturnType();
 
@@ -37,6 +37,7 @@
 #include <iostream>
 
 #include <vector>
+#include <set>
 using std::cerr;
 using std::cout;
 using std::endl;
@@ -60,6 +61,28 @@ namespace Dyninst {
             }
         };
 
+        struct sortByBucket {
+            bool operator()(const std::pair<unsigned, Symbol *> &lhs, const std::pair<unsigned, Symbol *> &rhs) {
+                return lhs.first < rhs.first;
+            }
+        };
+
+        // Puts back the Symbols' indices when it goes out of scope, so
+        // renumbering done for one emitted image doesn't stick to the Symtab
+        class restoreSymIndices {
+        public:
+            void save(const std::vector<Symbol *> &syms) {
+                for (unsigned i = 0; i < syms.size(); i++)
+                    saved.push_back(std::make_pair(syms[i], syms[i]->getIndex()));
+            }
+            ~restoreSymIndices() {
+                for (unsigned i = 0; i < saved.size(); i++)
+                    saved[i].first->setIndex(saved[i].second);
+            }
+        private:
+            std::vector<std::pair<Symbol *, int> > saved;
+        };
+
         struct ElfTypes32 {
             typedef Elf32_Ehdr Elf_Ehdr;
             typedef Elf32_Phdr Elf_Phdr;
@@ -217,6 +240,9 @@ namespace Dyninst {
             bool movePHdrsFirst;
             bool createNewPhdr;
             bool replaceNOTE;
+            // Dynamic symbol hash tables to write (see Symtab::setHashStyle)
+            bool sysvHash;
+            bool gnuHash;
             unsigned loadSecTotalSize;
 
             bool isStripped;
@@ -255,7 +281,15 @@ namespace Dyninst {
                                       unsigned &verdefSecSize, unsigned &dynSymbolNamesLength,
                                       std::vector<std::string> &dynStrs);
 
-            void createHashSection(Elf_Word *&hashsecData, unsigned &hashsecSize, std::vector<Symbol *> &dynSymbols);
+            void findSysvUnhashed(std::vector<Symbol *> &dynSymbols, std::set<Symbol *> &unhashed);
+
+            void createHashSection(Elf_Word *&hashsecData, unsigned &hashsecSize, std::vector<Symbol *> &dynSymbols,
+                                   std::set<Symbol *> &unhashed);
+
+            unsigned sortDynSymsForGnuHash(std::vector<Symbol *> &dynSymbols);
+
+            void createGnuHashSection(char *&gnuhashData, unsigned &gnuhashSize, std::vector<Symbol *> &dynSymbols,
+                                      unsigned symndx);
 
             void createDynamicSection(void *dynData, unsigned size, Elf_Dyn *&dynsecData, unsigned &dynsecSize,
                                       unsigned &dynSymbolNamesLength, std::vector<std::string> &dynStrs);